@@ -1,510 +1,4263 @@
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <charconv>
 #include <cmath>
 #include <compare>
+#include <concepts>
+#include <cstddef>
+#include <condition_variable>
+#include <deque>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
 #include <vector>
 #include <iostream>
 
-// CLASS BIGINTEGER
+// x86-64 builds add AVX2 and AVX-512 variants of the hot kernels, picked at runtime from CPUID. Define
+// BIGINTEGER_NO_SIMD to keep only the portable ones.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(BIGINTEGER_NO_SIMD)
+#define BIGINTEGER_X86_SIMD
+#include <immintrin.h>
+#endif
 
-class BigInteger {
+// MPN KERNELS
+
+// Allocation-free kernels over raw little-endian limb spans, in the style of GMP's mpn layer. A result
+// span may coincide with an operand span (in-place operation) but must not partially overlap it.
+namespace mpn {
+
+using limb = uint32_t;
+using double_limb = uint64_t;
+
+const int LIMB_BITS = 32;
+
+// result = first + second, returns the carry
+limb add_n(limb* result, const limb* first, const limb* second, size_t size);
+// result = first + value, returns the carry
+limb add_1(limb* result, const limb* first, size_t size, limb value);
+// result = first - second, returns the borrow
+limb sub_n(limb* result, const limb* first, const limb* second, size_t size);
+// result = first - value, returns the borrow
+limb sub_1(limb* result, const limb* first, size_t size, limb value);
+// Sign of first - second
+int cmp_n(const limb* first, const limb* second, size_t size);
+// result = first * multiplier, returns the high limb
+limb mul_1(limb* result, const limb* first, size_t size, limb multiplier);
+// result += first * multiplier, returns the carry out of result
+limb addmul_1(limb* result, const limb* first, size_t size, limb multiplier);
+// result -= first * multiplier, returns the borrow out of result
+limb submul_1(limb* result, const limb* first, size_t size, limb multiplier);
+// quotient = dividend / divider, returns the remainder
+limb divrem_1(limb* quotient, const limb* dividend, size_t size, limb divider);
+// NTT butterflies over residues below modulus < 2^30: with t = roots[k] * odd[k], even[k] and odd[k]
+// become even[k] + t and even[k] - t. quotients[k] = floor(roots[k] * 2^32 / modulus) serves Shoup's
+// modular multiplication.
+void ntt_butterflies(unsigned* even, unsigned* odd, const unsigned* roots, const unsigned* quotients, size_t size, unsigned modulus);
+
+enum class simd_level { SCALAR, AVX2, AVX512 };
+// Widest vector extension the kernels use on this CPU, detected once
+simd_level simd_support();
+
+// Kernels below this many limbs stay on the scalar path
+const size_t SIMD_MIN_SIZE = 16;
+
+#ifdef BIGINTEGER_X86_SIMD
+
+// AVX2 and AVX-512 variants work on 8 or 16 limbs per step. The carries between lanes are resolved by
+// a lookahead over the lane masks: a lane generates a carry or passes an incoming one on, so with
+// generate and propagate bit masks the carries into all lanes are ((generate << 1 | carry) + propagate)
+// ^ propagate. Multiplications split every product into a low and a high limb, the high limbs move
+// one lane up and are added with the same lookahead.
+
+__attribute__((target("avx2"))) inline __m256i less_avx2(__m256i first, __m256i second) {
+  const __m256i sign = _mm256_set1_epi32(INT32_MIN);
+  return _mm256_cmpgt_epi32(_mm256_xor_si256(second, sign), _mm256_xor_si256(first, sign));
+}
+
+// All-ones in the lanes that receive a carry, carry becomes the carry out of the top lane
+__attribute__((target("avx2"))) inline __m256i carry_lanes_avx2(__m256i generate, __m256i propagate, limb& carry) {
+  const __m256i lane_bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+  unsigned generated = _mm256_movemask_ps(_mm256_castsi256_ps(generate));
+  unsigned propagated = _mm256_movemask_ps(_mm256_castsi256_ps(propagate));
+  unsigned carries = (((generated << 1) | carry) + propagated) ^ propagated;
+  carry = carries >> 8;
+  return _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(carries), lane_bits), lane_bits);
+}
+
+__attribute__((target("avx2"))) inline void mul_lanes_avx2(__m256i first, __m256i multiplier, __m256i& low, __m256i& high) {
+  __m256i even = _mm256_mul_epu32(first, multiplier);
+  __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(first, 32), multiplier);
+  low = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+  high = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+}
+
+// Lanes of value moved one up, lane 0 takes the top lane of previous
+__attribute__((target("avx2"))) inline __m256i shift_lanes_avx2(__m256i value, __m256i previous) {
+  const __m256i rotate = _mm256_setr_epi32(7, 0, 1, 2, 3, 4, 5, 6);
+  return _mm256_blend_epi32(_mm256_permutevar8x32_epi32(value, rotate), _mm256_permutevar8x32_epi32(previous, rotate), 0x01);
+}
+
+__attribute__((target("avx2"))) limb add_n_avx2(limb* result, const limb* first, const limb* second, size_t size) {
+  const __m256i ones = _mm256_set1_epi32(-1);
+  limb carry = 0;
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i));
+    __m256i sum = _mm256_add_epi32(value, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(second + i)));
+    __m256i carries = carry_lanes_avx2(less_avx2(sum, value), _mm256_cmpeq_epi32(sum, ones), carry);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(result + i), _mm256_sub_epi32(sum, carries));
+  }
+  for (; i < size; ++i) {
+    double_limb sum = static_cast<double_limb>(first[i]) + second[i] + carry;
+    result[i] = static_cast<limb>(sum);
+    carry = sum >> LIMB_BITS;
+  }
+  return carry;
+}
+
+__attribute__((target("avx2"))) limb sub_n_avx2(limb* result, const limb* first, const limb* second, size_t size) {
+  limb borrow = 0;
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i));
+    __m256i other = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(second + i));
+    __m256i diff = _mm256_sub_epi32(value, other);
+    __m256i borrows = carry_lanes_avx2(less_avx2(value, other), _mm256_cmpeq_epi32(diff, _mm256_setzero_si256()), borrow);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(result + i), _mm256_add_epi32(diff, borrows));
+  }
+  for (; i < size; ++i) {
+    double_limb diff = static_cast<double_limb>(first[i]) - second[i] - borrow;
+    result[i] = static_cast<limb>(diff);
+    borrow = diff >> (2 * LIMB_BITS - 1);
+  }
+  return borrow;
+}
+
+__attribute__((target("avx2"))) limb mul_1_avx2(limb* result, const limb* first, size_t size, limb multiplier) {
+  const __m256i ones = _mm256_set1_epi32(-1);
+  const __m256i factor = _mm256_set1_epi32(multiplier);
+  __m256i previous = _mm256_setzero_si256();
+  limb carry = 0;
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    __m256i low, high;
+    mul_lanes_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i)), factor, low, high);
+    __m256i sum = _mm256_add_epi32(low, shift_lanes_avx2(high, previous));
+    previous = high;
+    __m256i carries = carry_lanes_avx2(less_avx2(sum, low), _mm256_cmpeq_epi32(sum, ones), carry);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(result + i), _mm256_sub_epi32(sum, carries));
+  }
+  double_limb high_carry = static_cast<double_limb>(static_cast<limb>(_mm256_extract_epi32(previous, 7))) + carry;
+  for (; i < size; ++i) {
+    double_limb product = static_cast<double_limb>(first[i]) * multiplier + high_carry;
+    result[i] = static_cast<limb>(product);
+    high_carry = product >> LIMB_BITS;
+  }
+  return high_carry;
+}
+
+__attribute__((target("avx2"))) limb addmul_1_avx2(limb* result, const limb* first, size_t size, limb multiplier) {
+  const __m256i ones = _mm256_set1_epi32(-1);
+  const __m256i factor = _mm256_set1_epi32(multiplier);
+  __m256i previous = _mm256_setzero_si256();
+  limb carry = 0;
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(result + i));
+    __m256i low, high;
+    mul_lanes_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i)), factor, low, high);
+    __m256i partial = _mm256_add_epi32(value, low);
+    // The carry of value + low joins the high limb, which stays below 2^32
+    high = _mm256_sub_epi32(high, less_avx2(partial, value));
+    __m256i sum = _mm256_add_epi32(partial, shift_lanes_avx2(high, previous));
+    previous = high;
+    __m256i carries = carry_lanes_avx2(less_avx2(sum, partial), _mm256_cmpeq_epi32(sum, ones), carry);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(result + i), _mm256_sub_epi32(sum, carries));
+  }
+  double_limb high_carry = static_cast<double_limb>(static_cast<limb>(_mm256_extract_epi32(previous, 7))) + carry;
+  for (; i < size; ++i) {
+    double_limb product = static_cast<double_limb>(first[i]) * multiplier + result[i] + high_carry;
+    result[i] = static_cast<limb>(product);
+    high_carry = product >> LIMB_BITS;
+  }
+  return high_carry;
+}
+
+__attribute__((target("avx2"))) limb submul_1_avx2(limb* result, const limb* first, size_t size, limb multiplier) {
+  const __m256i factor = _mm256_set1_epi32(multiplier);
+  __m256i previous = _mm256_setzero_si256();
+  limb borrow = 0;
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(result + i));
+    __m256i low, high;
+    mul_lanes_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i)), factor, low, high);
+    __m256i partial = _mm256_sub_epi32(value, low);
+    high = _mm256_sub_epi32(high, less_avx2(value, low));
+    __m256i subtrahend = shift_lanes_avx2(high, previous);
+    previous = high;
+    __m256i diff = _mm256_sub_epi32(partial, subtrahend);
+    __m256i borrows = carry_lanes_avx2(less_avx2(partial, subtrahend), _mm256_cmpeq_epi32(partial, subtrahend), borrow);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(result + i), _mm256_add_epi32(diff, borrows));
+  }
+  double_limb high_borrow = static_cast<double_limb>(static_cast<limb>(_mm256_extract_epi32(previous, 7))) + borrow;
+  for (; i < size; ++i) {
+    double_limb product = static_cast<double_limb>(first[i]) * multiplier + high_borrow;
+    limb low = static_cast<limb>(product);
+    high_borrow = (product >> LIMB_BITS) + (result[i] < low);
+    result[i] -= low;
+  }
+  return high_borrow;
+}
+
+// Shoup's multiplication: q = floor(odd * quotient / 2^32) leaves odd * root - q * modulus in [0, 2 * modulus)
+__attribute__((target("avx2"))) size_t ntt_butterflies_avx2(unsigned* even, unsigned* odd, const unsigned* roots, const unsigned* quotients, size_t size, unsigned modulus) {
+  const __m256i prime = _mm256_set1_epi32(modulus);
+  size_t k = 0;
+  for (; k + 8 <= size; k += 8) {
+    __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(even + k));
+    __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(odd + k));
+    __m256i root = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(roots + k));
+    __m256i quotient = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(quotients + k));
+    __m256i q_even = _mm256_srli_epi64(_mm256_mul_epu32(b, quotient), 32);
+    __m256i q_odd = _mm256_mul_epu32(_mm256_srli_epi64(b, 32), _mm256_srli_epi64(quotient, 32));
+    __m256i q = _mm256_blend_epi32(q_even, q_odd, 0xAA);
+    __m256i t = _mm256_sub_epi32(_mm256_mullo_epi32(b, root), _mm256_mullo_epi32(q, prime));
+    t = _mm256_min_epu32(t, _mm256_sub_epi32(t, prime));
+    __m256i sum = _mm256_add_epi32(a, t);
+    __m256i diff = _mm256_add_epi32(_mm256_sub_epi32(a, t), prime);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(even + k), _mm256_min_epu32(sum, _mm256_sub_epi32(sum, prime)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(odd + k), _mm256_min_epu32(diff, _mm256_sub_epi32(diff, prime)));
+  }
+  return k;
+}
+
+// GCC 12 reports its own _mm512_undefined_epi32() placeholders as uninitialized
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+__attribute__((target("avx512f"))) inline __mmask16 carry_lanes_avx512(__mmask16 generate, __mmask16 propagate, limb& carry) {
+  unsigned carries = (((static_cast<unsigned>(generate) << 1) | carry) + propagate) ^ propagate;
+  carry = carries >> 16;
+  return static_cast<__mmask16>(carries);
+}
+
+__attribute__((target("avx512f"))) inline void mul_lanes_avx512(__m512i first, __m512i multiplier, __m512i& low, __m512i& high) {
+  __m512i even = _mm512_mul_epu32(first, multiplier);
+  __m512i odd = _mm512_mul_epu32(_mm512_srli_epi64(first, 32), multiplier);
+  low = _mm512_mask_blend_epi32(0xAAAA, even, _mm512_slli_epi64(odd, 32));
+  high = _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(even, 32), odd);
+}
+
+__attribute__((target("avx512f"))) inline limb top_lane_avx512(__m512i value) {
+  return static_cast<limb>(_mm_extract_epi32(_mm512_extracti32x4_epi32(value, 3), 3));
+}
+
+__attribute__((target("avx512f"))) limb add_n_avx512(limb* result, const limb* first, const limb* second, size_t size) {
+  const __m512i ones = _mm512_set1_epi32(-1);
+  const __m512i one = _mm512_set1_epi32(1);
+  limb carry = 0;
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    __m512i value = _mm512_loadu_si512(first + i);
+    __m512i sum = _mm512_add_epi32(value, _mm512_loadu_si512(second + i));
+    __mmask16 carries = carry_lanes_avx512(_mm512_cmplt_epu32_mask(sum, value), _mm512_cmpeq_epi32_mask(sum, ones), carry);
+    _mm512_storeu_si512(result + i, _mm512_mask_add_epi32(sum, carries, sum, one));
+  }
+  for (; i < size; ++i) {
+    double_limb sum = static_cast<double_limb>(first[i]) + second[i] + carry;
+    result[i] = static_cast<limb>(sum);
+    carry = sum >> LIMB_BITS;
+  }
+  return carry;
+}
+
+__attribute__((target("avx512f"))) limb sub_n_avx512(limb* result, const limb* first, const limb* second, size_t size) {
+  const __m512i one = _mm512_set1_epi32(1);
+  limb borrow = 0;
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    __m512i value = _mm512_loadu_si512(first + i);
+    __m512i other = _mm512_loadu_si512(second + i);
+    __m512i diff = _mm512_sub_epi32(value, other);
+    __mmask16 borrows = carry_lanes_avx512(_mm512_cmplt_epu32_mask(value, other), _mm512_cmpeq_epi32_mask(value, other), borrow);
+    _mm512_storeu_si512(result + i, _mm512_mask_sub_epi32(diff, borrows, diff, one));
+  }
+  for (; i < size; ++i) {
+    double_limb diff = static_cast<double_limb>(first[i]) - second[i] - borrow;
+    result[i] = static_cast<limb>(diff);
+    borrow = diff >> (2 * LIMB_BITS - 1);
+  }
+  return borrow;
+}
+
+__attribute__((target("avx512f"))) limb mul_1_avx512(limb* result, const limb* first, size_t size, limb multiplier) {
+  const __m512i ones = _mm512_set1_epi32(-1);
+  const __m512i one = _mm512_set1_epi32(1);
+  const __m512i factor = _mm512_set1_epi32(multiplier);
+  __m512i previous = _mm512_setzero_si512();
+  limb carry = 0;
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    __m512i low, high;
+    mul_lanes_avx512(_mm512_loadu_si512(first + i), factor, low, high);
+    __m512i sum = _mm512_add_epi32(low, _mm512_alignr_epi32(high, previous, 15));
+    previous = high;
+    __mmask16 carries = carry_lanes_avx512(_mm512_cmplt_epu32_mask(sum, low), _mm512_cmpeq_epi32_mask(sum, ones), carry);
+    _mm512_storeu_si512(result + i, _mm512_mask_add_epi32(sum, carries, sum, one));
+  }
+  double_limb high_carry = static_cast<double_limb>(top_lane_avx512(previous)) + carry;
+  for (; i < size; ++i) {
+    double_limb product = static_cast<double_limb>(first[i]) * multiplier + high_carry;
+    result[i] = static_cast<limb>(product);
+    high_carry = product >> LIMB_BITS;
+  }
+  return high_carry;
+}
+
+__attribute__((target("avx512f"))) limb addmul_1_avx512(limb* result, const limb* first, size_t size, limb multiplier) {
+  const __m512i ones = _mm512_set1_epi32(-1);
+  const __m512i one = _mm512_set1_epi32(1);
+  const __m512i factor = _mm512_set1_epi32(multiplier);
+  __m512i previous = _mm512_setzero_si512();
+  limb carry = 0;
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    __m512i value = _mm512_loadu_si512(result + i);
+    __m512i low, high;
+    mul_lanes_avx512(_mm512_loadu_si512(first + i), factor, low, high);
+    __m512i partial = _mm512_add_epi32(value, low);
+    high = _mm512_mask_add_epi32(high, _mm512_cmplt_epu32_mask(partial, value), high, one);
+    __m512i sum = _mm512_add_epi32(partial, _mm512_alignr_epi32(high, previous, 15));
+    previous = high;
+    __mmask16 carries = carry_lanes_avx512(_mm512_cmplt_epu32_mask(sum, partial), _mm512_cmpeq_epi32_mask(sum, ones), carry);
+    _mm512_storeu_si512(result + i, _mm512_mask_add_epi32(sum, carries, sum, one));
+  }
+  double_limb high_carry = static_cast<double_limb>(top_lane_avx512(previous)) + carry;
+  for (; i < size; ++i) {
+    double_limb product = static_cast<double_limb>(first[i]) * multiplier + result[i] + high_carry;
+    result[i] = static_cast<limb>(product);
+    high_carry = product >> LIMB_BITS;
+  }
+  return high_carry;
+}
+
+__attribute__((target("avx512f"))) limb submul_1_avx512(limb* result, const limb* first, size_t size, limb multiplier) {
+  const __m512i one = _mm512_set1_epi32(1);
+  const __m512i factor = _mm512_set1_epi32(multiplier);
+  __m512i previous = _mm512_setzero_si512();
+  limb borrow = 0;
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    __m512i value = _mm512_loadu_si512(result + i);
+    __m512i low, high;
+    mul_lanes_avx512(_mm512_loadu_si512(first + i), factor, low, high);
+    __m512i partial = _mm512_sub_epi32(value, low);
+    high = _mm512_mask_add_epi32(high, _mm512_cmplt_epu32_mask(value, low), high, one);
+    __m512i subtrahend = _mm512_alignr_epi32(high, previous, 15);
+    previous = high;
+    __m512i diff = _mm512_sub_epi32(partial, subtrahend);
+    __mmask16 borrows = carry_lanes_avx512(_mm512_cmplt_epu32_mask(partial, subtrahend), _mm512_cmpeq_epi32_mask(partial, subtrahend), borrow);
+    _mm512_storeu_si512(result + i, _mm512_mask_sub_epi32(diff, borrows, diff, one));
+  }
+  double_limb high_borrow = static_cast<double_limb>(top_lane_avx512(previous)) + borrow;
+  for (; i < size; ++i) {
+    double_limb product = static_cast<double_limb>(first[i]) * multiplier + high_borrow;
+    limb low = static_cast<limb>(product);
+    high_borrow = (product >> LIMB_BITS) + (result[i] < low);
+    result[i] -= low;
+  }
+  return high_borrow;
+}
+
+__attribute__((target("avx512f"))) size_t ntt_butterflies_avx512(unsigned* even, unsigned* odd, const unsigned* roots, const unsigned* quotients, size_t size, unsigned modulus) {
+  const __m512i prime = _mm512_set1_epi32(modulus);
+  size_t k = 0;
+  for (; k + 16 <= size; k += 16) {
+    __m512i a = _mm512_loadu_si512(even + k);
+    __m512i b = _mm512_loadu_si512(odd + k);
+    __m512i quotient = _mm512_loadu_si512(quotients + k);
+    __m512i q_even = _mm512_srli_epi64(_mm512_mul_epu32(b, quotient), 32);
+    __m512i q_odd = _mm512_mul_epu32(_mm512_srli_epi64(b, 32), _mm512_srli_epi64(quotient, 32));
+    __m512i q = _mm512_mask_blend_epi32(0xAAAA, q_even, q_odd);
+    __m512i t = _mm512_sub_epi32(_mm512_mullo_epi32(b, _mm512_loadu_si512(roots + k)), _mm512_mullo_epi32(q, prime));
+    t = _mm512_min_epu32(t, _mm512_sub_epi32(t, prime));
+    __m512i sum = _mm512_add_epi32(a, t);
+    __m512i diff = _mm512_add_epi32(_mm512_sub_epi32(a, t), prime);
+    _mm512_storeu_si512(even + k, _mm512_min_epu32(sum, _mm512_sub_epi32(sum, prime)));
+    _mm512_storeu_si512(odd + k, _mm512_min_epu32(diff, _mm512_sub_epi32(diff, prime)));
+  }
+  return k;
+}
+
+#pragma GCC diagnostic pop
+
+#endif
+
+simd_level simd_support() {
+#ifdef BIGINTEGER_X86_SIMD
+  static const simd_level level = [] {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+      return simd_level::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+      return simd_level::AVX2;
+    }
+    return simd_level::SCALAR;
+  }();
+  return level;
+#else
+  return simd_level::SCALAR;
+#endif
+}
+
+
+limb add_n(limb* result, const limb* first, const limb* second, size_t size) {
+#ifdef BIGINTEGER_X86_SIMD
+  if (size >= SIMD_MIN_SIZE && simd_support() != simd_level::SCALAR) {
+    return simd_support() == simd_level::AVX512 ? add_n_avx512(result, first, second, size) : add_n_avx2(result, first, second, size);
+  }
+#endif
+  double_limb carry = 0;
+  for (size_t i = 0; i < size; ++i) {
+    double_limb sum = carry + first[i] + second[i];
+    result[i] = static_cast<limb>(sum);
+    carry = sum >> LIMB_BITS;
+  }
+  return carry;
+}
+
+limb add_1(limb* result, const limb* first, size_t size, limb value) {
+  for (size_t i = 0; i < size; ++i) {
+    double_limb sum = static_cast<double_limb>(first[i]) + value;
+    result[i] = static_cast<limb>(sum);
+    value = sum >> LIMB_BITS;
+    if (value == 0) {
+      if (result != first) {
+        std::copy(first + i + 1, first + size, result + i + 1);
+      }
+      return 0;
+    }
+  }
+  return value;
+}
+
+limb sub_n(limb* result, const limb* first, const limb* second, size_t size) {
+#ifdef BIGINTEGER_X86_SIMD
+  if (size >= SIMD_MIN_SIZE && simd_support() != simd_level::SCALAR) {
+    return simd_support() == simd_level::AVX512 ? sub_n_avx512(result, first, second, size) : sub_n_avx2(result, first, second, size);
+  }
+#endif
+  double_limb borrow = 0;
+  for (size_t i = 0; i < size; ++i) {
+    double_limb diff = static_cast<double_limb>(first[i]) - second[i] - borrow;
+    result[i] = static_cast<limb>(diff);
+    borrow = diff >> (2 * LIMB_BITS - 1);
+  }
+  return borrow;
+}
+
+limb sub_1(limb* result, const limb* first, size_t size, limb value) {
+  for (size_t i = 0; i < size; ++i) {
+    double_limb diff = static_cast<double_limb>(first[i]) - value;
+    result[i] = static_cast<limb>(diff);
+    value = diff >> (2 * LIMB_BITS - 1);
+    if (value == 0) {
+      if (result != first) {
+        std::copy(first + i + 1, first + size, result + i + 1);
+      }
+      return 0;
+    }
+  }
+  return value;
+}
+
+int cmp_n(const limb* first, const limb* second, size_t size) {
+  for (size_t i = size; i > 0; --i) {
+    if (first[i - 1] != second[i - 1]) {
+      return first[i - 1] < second[i - 1] ? -1 : 1;
+    }
+  }
+  return 0;
+}
+
+limb mul_1(limb* result, const limb* first, size_t size, limb multiplier) {
+#ifdef BIGINTEGER_X86_SIMD
+  if (size >= SIMD_MIN_SIZE && simd_support() != simd_level::SCALAR) {
+    return simd_support() == simd_level::AVX512 ? mul_1_avx512(result, first, size, multiplier) : mul_1_avx2(result, first, size, multiplier);
+  }
+#endif
+  double_limb carry = 0;
+  for (size_t i = 0; i < size; ++i) {
+    double_limb product = static_cast<double_limb>(first[i]) * multiplier + carry;
+    result[i] = static_cast<limb>(product);
+    carry = product >> LIMB_BITS;
+  }
+  return carry;
+}
+
+limb addmul_1(limb* result, const limb* first, size_t size, limb multiplier) {
+#ifdef BIGINTEGER_X86_SIMD
+  if (size >= SIMD_MIN_SIZE && simd_support() != simd_level::SCALAR) {
+    return simd_support() == simd_level::AVX512 ? addmul_1_avx512(result, first, size, multiplier) : addmul_1_avx2(result, first, size, multiplier);
+  }
+#endif
+  double_limb carry = 0;
+  for (size_t i = 0; i < size; ++i) {
+    double_limb product = static_cast<double_limb>(first[i]) * multiplier + result[i] + carry;
+    result[i] = static_cast<limb>(product);
+    carry = product >> LIMB_BITS;
+  }
+  return carry;
+}
+
+limb submul_1(limb* result, const limb* first, size_t size, limb multiplier) {
+#ifdef BIGINTEGER_X86_SIMD
+  if (size >= SIMD_MIN_SIZE && simd_support() != simd_level::SCALAR) {
+    return simd_support() == simd_level::AVX512 ? submul_1_avx512(result, first, size, multiplier) : submul_1_avx2(result, first, size, multiplier);
+  }
+#endif
+  double_limb carry = 0;
+  for (size_t i = 0; i < size; ++i) {
+    double_limb product = static_cast<double_limb>(first[i]) * multiplier + carry;
+    limb low = static_cast<limb>(product);
+    carry = (product >> LIMB_BITS) + (result[i] < low);
+    result[i] -= low;
+  }
+  return carry;
+}
+
+limb divrem_1(limb* quotient, const limb* dividend, size_t size, limb divider) {
+  double_limb remainder = 0;
+  for (size_t i = size; i > 0; --i) {
+    double_limb current = (remainder << LIMB_BITS) | dividend[i - 1];
+    quotient[i - 1] = current / divider;
+    remainder = current % divider;
+  }
+  return remainder;
+}
+
+void ntt_butterflies(unsigned* even, unsigned* odd, const unsigned* roots, const unsigned* quotients, size_t size, unsigned modulus) {
+  size_t k = 0;
+#ifdef BIGINTEGER_X86_SIMD
+  if (simd_support() == simd_level::AVX512) {
+    k = ntt_butterflies_avx512(even, odd, roots, quotients, size, modulus);
+  } else if (simd_support() == simd_level::AVX2) {
+    k = ntt_butterflies_avx2(even, odd, roots, quotients, size, modulus);
+  }
+#endif
+  for (; k < size; ++k) {
+    unsigned q = (static_cast<double_limb>(odd[k]) * quotients[k]) >> LIMB_BITS;
+    unsigned t = odd[k] * roots[k] - q * modulus;
+    t = (t >= modulus) ? t - modulus : t;
+    unsigned sum = even[k] + t;
+    unsigned diff = even[k] + modulus - t;
+    even[k] = (sum >= modulus) ? sum - modulus : sum;
+    odd[k] = (diff >= modulus) ? diff - modulus : diff;
+  }
+}
+
+}  // namespace mpn
+
+// CLASS MEMORYSCOPE
+
+// Limb storage comes from the memory resource current on the allocating thread, nullptr standing for
+// the global heap. A MemoryScope makes its resource current until the scope ends. Every block records
+// the resource it came from, so values may outlive the scope, though not the resource itself.
+class MemoryScope {
  public:
-  BigInteger(): sign_(sign::ZERO) {};
-  BigInteger(long long num);
-  BigInteger(const std::string& str);
-  BigInteger(const BigInteger& other) = default;
-  ~BigInteger() = default;
+  explicit MemoryScope(std::pmr::memory_resource* resource): previous_(current()) { current() = resource; }
+  MemoryScope(const MemoryScope&) = delete;
+  MemoryScope& operator=(const MemoryScope&) = delete;
+  ~MemoryScope() { current() = previous_; }
 
-  BigInteger& operator=(const BigInteger& other) = default;
+  static std::pmr::memory_resource* resource() { return current(); }
 
-  BigInteger& operator+=(const BigInteger& other);
-  BigInteger& operator-=(const BigInteger& other);
-  BigInteger& operator*=(const BigInteger& other);
-  BigInteger& operator/=(const BigInteger& other);
-  BigInteger& operator%=(const BigInteger& other);
+ private:
+  std::pmr::memory_resource* previous_;
 
-  BigInteger operator-() const;
-  BigInteger& operator++();
-  BigInteger operator++(int);
-  BigInteger& operator--();
-  BigInteger operator--(int);
-  explicit operator bool() const;
+  static std::pmr::memory_resource*& current();
+};
 
-  std::string toString() const;
+std::pmr::memory_resource*& MemoryScope::current() {
+  thread_local std::pmr::memory_resource* resource = nullptr;
+  return resource;
+}
+
+// CLASS SCRATCHSCOPE
+
+// While a ScratchScope is alive, limb storage on its thread comes from a thread-local bump arena, where
+// allocating moves a pointer and freeing only counts the block. The outermost scope rewinds the arena
+// in one go when it ends, provided all its blocks are gone; otherwise the values still holding blocks
+// keep that arena alive on their own and the thread starts a new one. Large blocks bypass the arena.
+class ScratchScope {
+ public:
+  ScratchScope();
+  ScratchScope(const ScratchScope&) = delete;
+  ScratchScope& operator=(const ScratchScope&) = delete;
+  ~ScratchScope();
 
  private:
-  static const int BASE = 1'000'000'000;
-  static const int SIZE = 9;
+  class Arena;
+  class Resource;
 
-  enum class sign : int8_t {
-    NEGATIVE = -1,
-    ZERO = 0,
-    POSITIVE = 1
+  struct ThreadState {
+    Arena* arena = nullptr;
+    size_t depth = 0;
+    ~ThreadState();
+  };
+
+  MemoryScope memory_;
+
+  static ThreadState& state();
+  static Resource* resource();
+};
+
+class ScratchScope::Arena {
+ public:
+  Arena(): initial_(new std::byte[INITIAL_SIZE]), buffer_(initial_.get(), INITIAL_SIZE) {}
+
+  void* allocate(size_t bytes) {
+    ++references_;
+    used_ += bytes;
+    return buffer_.allocate(bytes, alignof(std::max_align_t));
+  }
+  // Past CAPACITY bytes the thread moves on to a new arena, so an escaped block pins a bounded amount
+  bool full() const { return used_ >= CAPACITY; }
+  bool idle() const { return references_ == 1; }
+  void rewind() {
+    buffer_.release();
+    used_ = 0;
+  }
+  void release() {
+    if (--references_ == 0) {
+      delete this;
+    }
+  }
+
+ private:
+  static const size_t INITIAL_SIZE = size_t(1) << 18;
+  static const size_t CAPACITY = size_t(1) << 22;
+
+  std::unique_ptr<std::byte[]> initial_;
+  std::pmr::monotonic_buffer_resource buffer_;
+  // Live blocks plus one for the thread while it allocates from the arena
+  std::atomic<size_t> references_ = 1;
+  size_t used_ = 0;
+};
+
+// The resource scratch scopes make current, blocks start with a header naming their arena (nullptr for
+// blocks too large for it)
+class ScratchScope::Resource : public std::pmr::memory_resource {
+ private:
+  static const size_t HEADER_SIZE = alignof(std::max_align_t);
+  static const size_t BLOCK_LIMIT = size_t(1) << 16;
+
+  void* do_allocate(size_t bytes, size_t) override {
+    bytes += HEADER_SIZE;
+    Arena* arena = nullptr;
+    void* block;
+    if (bytes <= BLOCK_LIMIT) {
+      Arena*& current = state().arena;
+      if (current != nullptr && current->full()) {
+        current->release();
+        current = nullptr;
+      }
+      if (current == nullptr) {
+        current = new Arena;
+      }
+      arena = current;
+      block = arena->allocate(bytes);
+    } else {
+      block = ::operator new(bytes);
+    }
+    *static_cast<Arena**>(block) = arena;
+    return static_cast<std::byte*>(block) + HEADER_SIZE;
+  }
+
+  void do_deallocate(void* pointer, size_t, size_t) override {
+    void* block = static_cast<std::byte*>(pointer) - HEADER_SIZE;
+    Arena* arena = *static_cast<Arena**>(block);
+    if (arena == nullptr) {
+      ::operator delete(block);
+    } else {
+      arena->release();
+    }
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+};
+
+ScratchScope::ScratchScope(): memory_(resource()) {
+  ++state().depth;
+}
+
+ScratchScope::~ScratchScope() {
+  ThreadState& thread = state();
+  if (--thread.depth == 0 && thread.arena != nullptr) {
+    if (thread.arena->idle()) {
+      thread.arena->rewind();
+    } else {
+      thread.arena->release();
+      thread.arena = nullptr;
+    }
+  }
+}
+
+ScratchScope::ThreadState::~ThreadState() {
+  if (arena != nullptr) {
+    arena->release();
+  }
+}
+
+ScratchScope::ThreadState& ScratchScope::state() {
+  thread_local ThreadState thread;
+  return thread;
+}
+
+// Never destroyed, blocks may be freed during static destruction
+ScratchScope::Resource* ScratchScope::resource() {
+  static Resource* front = new Resource;
+  return front;
+}
+
+// CLASS LIMBVECTOR
+
+// Contiguous limb storage with std::vector's interface. Up to INLINE_CAPACITY limbs live inside the
+// object itself, larger ones come from the current MemoryScope resource. Copies share a block from
+// the global heap under an atomic reference count, mutable access first gives a shared vector its
+// own copy, so copying is O(1) and read-only values may be shared across threads. Blocks from other
+// resources are copied limb by limb, a copy never keeps a scoped resource or arena busy. A mutable
+// pointer stays valid only as long as no copy of the vector is made.
+class LimbVector {
+ public:
+  using value_type = mpn::limb;
+  using iterator = value_type*;
+  using const_iterator = const value_type*;
+
+  LimbVector(): storage_{}, size_(0), capacity_(INLINE_CAPACITY) {}
+  explicit LimbVector(size_t size, value_type value = 0);
+  LimbVector(const value_type* first, const value_type* last);
+  LimbVector(const LimbVector& other);
+  LimbVector(LimbVector&& other) noexcept;
+  ~LimbVector();
+
+  LimbVector& operator=(const LimbVector& other);
+  LimbVector& operator=(LimbVector&& other) noexcept;
+
+  value_type* data() {
+    unshare();
+    return raw();
+  }
+  const value_type* data() const { return raw(); }
+  size_t size() const { return size_; }
+  size_t capacity() const { return capacity_; }
+  bool empty() const { return size_ == 0; }
+
+  iterator begin() { return data(); }
+  iterator end() { return data() + size_; }
+  const_iterator begin() const { return data(); }
+  const_iterator end() const { return data() + size_; }
+
+  value_type& operator[](size_t index) { return data()[index]; }
+  const value_type& operator[](size_t index) const { return data()[index]; }
+  value_type& back() { return data()[size_ - 1]; }
+  const value_type& back() const { return data()[size_ - 1]; }
+
+  void reserve(size_t capacity);
+  void resize(size_t size, value_type value = 0);
+  void assign(size_t size, value_type value);
+  void assign(const value_type* first, const value_type* last);
+  void push_back(value_type value);
+  void pop_back() { --size_; }
+  void clear() { size_ = 0; }
+  void swap(LimbVector& other) noexcept;
+
+ private:
+  static const uint32_t INLINE_CAPACITY = 4;
+  // Heap blocks start with a header naming the memory resource they came from and counting the
+  // vectors that share them
+  struct Header {
+    std::pmr::memory_resource* resource;
+    std::atomic<uint32_t> references;
+  };
+  static const size_t HEADER_SIZE = alignof(std::max_align_t);
+  static_assert(sizeof(Header) <= HEADER_SIZE);
+
+  union Storage {
+    value_type* heap;
+    value_type limbs[INLINE_CAPACITY];
   };
 
-  std::vector<int> digits_;
-  BigInteger::sign sign_;
+  Storage storage_;
+  uint32_t size_;
+  uint32_t capacity_;
+
+  bool is_inline() const { return capacity_ == INLINE_CAPACITY; }
+  value_type* raw() const { return is_inline() ? const_cast<value_type*>(storage_.limbs) : storage_.heap; }
+  bool shared() const;
+  void unshare();
+  void reallocate(size_t capacity);
+  static Header* header(value_type* limbs);
+  static value_type* allocate(size_t capacity);
+  static void release(value_type* limbs, size_t capacity);
+};
+
+bool operator==(const LimbVector& first, const LimbVector& second);
+
+// Constructors
+
+LimbVector::LimbVector(size_t size, value_type value): LimbVector() {
+  assign(size, value);
+}
+
+LimbVector::LimbVector(const value_type* first, const value_type* last): LimbVector() {
+  assign(first, last);
+}
+
+LimbVector::LimbVector(const LimbVector& other): LimbVector() {
+  if (other.is_inline() || header(other.storage_.heap)->resource != nullptr) {
+    assign(other.begin(), other.end());
+    return;
+  }
+  header(other.storage_.heap)->references.fetch_add(1, std::memory_order_relaxed);
+  storage_.heap = other.storage_.heap;
+  size_ = other.size_;
+  capacity_ = other.capacity_;
+}
+
+LimbVector::LimbVector(LimbVector&& other) noexcept: LimbVector() {
+  swap(other);
+}
+
+LimbVector::~LimbVector() {
+  if (!is_inline()) {
+    release(storage_.heap, capacity_);
+  }
+}
+
+LimbVector& LimbVector::operator=(const LimbVector& other) {
+  if (this != &other) {
+    LimbVector copy(other);
+    swap(copy);
+  }
+  return *this;
+}
+
+LimbVector& LimbVector::operator=(LimbVector&& other) noexcept {
+  swap(other);
+  return *this;
+}
+
+bool operator==(const LimbVector& first, const LimbVector& second) {
+  return std::equal(first.begin(), first.end(), second.begin(), second.end());
+}
+
+// Size methods
+
+void LimbVector::reserve(size_t capacity) {
+  if (capacity > capacity_) {
+    reallocate(std::max<size_t>(capacity, 2 * size_t(capacity_)));
+  }
+}
+
+void LimbVector::resize(size_t size, value_type value) {
+  reserve(size);
+  if (size > size_) {
+    std::fill(end(), begin() + size, value);
+  }
+  size_ = static_cast<uint32_t>(size);
+}
+
+void LimbVector::assign(size_t size, value_type value) {
+  clear();
+  resize(size, value);
+}
+
+void LimbVector::assign(const value_type* first, const value_type* last) {
+  clear();
+  reserve(last - first);
+  std::copy(first, last, begin());
+  size_ = static_cast<uint32_t>(last - first);
+}
+
+void LimbVector::push_back(value_type value) {
+  if (size_ == capacity_) {
+    reserve(size_ + 1);
+  }
+  data()[size_++] = value;
+}
+
+// Sharing
+
+bool LimbVector::shared() const {
+  return !is_inline() && header(storage_.heap)->references.load(std::memory_order_acquire) != 1;
+}
+
+void LimbVector::unshare() {
+  if (shared()) {
+    reallocate(capacity_);
+  }
+}
+
+// Moves the limbs into a new block of the given capacity, the old one stays with its other owners
+void LimbVector::reallocate(size_t capacity) {
+  value_type* storage = allocate(capacity);
+  std::copy(raw(), raw() + size_, storage);
+  if (!is_inline()) {
+    release(storage_.heap, capacity_);
+  }
+  storage_.heap = storage;
+  capacity_ = static_cast<uint32_t>(capacity);
+}
+
+// Allocation
+
+LimbVector::Header* LimbVector::header(value_type* limbs) {
+  return reinterpret_cast<Header*>(reinterpret_cast<std::byte*>(limbs) - HEADER_SIZE);
+}
+
+LimbVector::value_type* LimbVector::allocate(size_t capacity) {
+  std::pmr::memory_resource* resource = MemoryScope::resource();
+  size_t bytes = HEADER_SIZE + capacity * sizeof(value_type);
+  void* block = (resource == nullptr) ? ::operator new(bytes) : resource->allocate(bytes, alignof(std::max_align_t));
+  new (block) Header{resource, 1};
+  return reinterpret_cast<value_type*>(static_cast<std::byte*>(block) + HEADER_SIZE);
+}
+
+// Drops one reference, the last owner frees the block
+void LimbVector::release(value_type* limbs, size_t capacity) {
+  Header* block = header(limbs);
+  if (block->references.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+    return;
+  }
+  std::pmr::memory_resource* resource = block->resource;
+  block->~Header();
+  if (resource == nullptr) {
+    ::operator delete(block);
+  } else {
+    resource->deallocate(block, HEADER_SIZE + capacity * sizeof(value_type), alignof(std::max_align_t));
+  }
+}
+
+void LimbVector::swap(LimbVector& other) noexcept {
+  // Inline limbs never point into the object, so the storage is exchanged as a whole
+  std::swap(storage_, other.storage_);
+  std::swap(size_, other.size_);
+  std::swap(capacity_, other.capacity_);
+}
+
+// CLASS THREADPOOL
+
+// Fork-join pool behind BigInteger's parallel mode. Forked tasks wait in a shared queue: idle workers
+// take the oldest (largest) ones, a joining thread takes back its own task if nobody has started it and
+// otherwise runs the newest queued tasks until its own one finishes, so nested forks never block a
+// thread that has work to do.
+class ThreadPool {
+ public:
+  static ThreadPool& instance();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ~ThreadPool();
+
+  // Threads taking part in parallel work, the calling one included (1 runs everything inline). Must not
+  // be changed while parallel work is running.
+  void setThreads(unsigned count);
+  unsigned threads() const { return threads_; }
+  // Operand size (in limbs) from which operations split their work
+  void setThreshold(size_t limbs) { threshold_ = limbs; }
+  size_t threshold() const { return threshold_; }
+
+  // Runs all functions, the ones after the first may run on other threads
+  template <class First, class... Rest>
+  void invoke(First&& first, Rest&&... rest);
+  // Runs body(i) for every i in [begin, end)
+  template <class Body>
+  void forEach(size_t begin, size_t end, Body&& body);
+
+ private:
+  struct Task {
+    Task(void (*run)(void*), void* function): run(run), function(function) {}
+
+    void (*run)(void*);
+    void* function;
+    bool done = false;
+    std::exception_ptr error;
+  };
+
+  std::vector<std::thread> workers_;
+  std::deque<Task*> queue_;
+  std::mutex mutex_;
+  std::condition_variable changed_;
+  bool stopping_ = false;
+  std::atomic<unsigned> threads_ = 1;
+  std::atomic<size_t> threshold_ = 500;
+
+  ThreadPool() = default;
+
+  void stop();
+  void work();
+  void fork(Task& task);
+  void join(Task& task);
+  void execute(Task& task);
+};
+
+ThreadPool& ThreadPool::instance() {
+  static ThreadPool pool;
+  return pool;
+}
+
+ThreadPool::~ThreadPool() {
+  stop();
+}
+
+void ThreadPool::setThreads(unsigned count) {
+  stop();
+  count = std::max(count, 1u);
+  stopping_ = false;
+  for (unsigned i = 1; i < count; ++i) {
+    workers_.emplace_back(&ThreadPool::work, this);
+  }
+  threads_ = count;
+}
+
+void ThreadPool::stop() {
+  {
+    std::lock_guard lock(mutex_);
+    stopping_ = true;
+  }
+  changed_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+  threads_ = 1;
+}
+
+template <class First, class... Rest>
+void ThreadPool::invoke(First&& first, Rest&&... rest) {
+  if constexpr (sizeof...(Rest) == 0) {
+    first();
+  } else {
+    auto others = [&] { invoke(std::forward<Rest>(rest)...); };
+    Task task([](void* function) { (*static_cast<decltype(others)*>(function))(); }, &others);
+    fork(task);
+    try {
+      first();
+    } catch (...) {
+      join(task);
+      throw;
+    }
+    join(task);
+  }
+}
+
+template <class Body>
+void ThreadPool::forEach(size_t begin, size_t end, Body&& body) {
+  if (end - begin == 1) {
+    body(begin);
+  } else if (begin < end) {
+    size_t middle = begin + (end - begin) / 2;
+    invoke([&] { forEach(begin, middle, body); }, [&] { forEach(middle, end, body); });
+  }
+}
+
+void ThreadPool::work() {
+  std::unique_lock lock(mutex_);
+  while (true) {
+    changed_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+    if (stopping_) {
+      return;
+    }
+    Task* task = queue_.front();
+    queue_.pop_front();
+    lock.unlock();
+    execute(*task);
+    lock.lock();
+  }
+}
+
+void ThreadPool::fork(Task& task) {
+  {
+    std::lock_guard lock(mutex_);
+    queue_.push_back(&task);
+  }
+  changed_.notify_all();
+}
+
+void ThreadPool::join(Task& task) {
+  std::unique_lock lock(mutex_);
+  auto queued = std::find(queue_.begin(), queue_.end(), &task);
+  if (queued != queue_.end()) {
+    queue_.erase(queued);
+    lock.unlock();
+    task.run(task.function);
+    return;
+  }
+  while (!task.done) {
+    if (queue_.empty()) {
+      changed_.wait(lock);
+      continue;
+    }
+    Task* other = queue_.back();
+    queue_.pop_back();
+    lock.unlock();
+    execute(*other);
+    lock.lock();
+  }
+  if (task.error) {
+    std::rethrow_exception(task.error);
+  }
+}
+
+void ThreadPool::execute(Task& task) {
+  try {
+    task.run(task.function);
+  } catch (...) {
+    task.error = std::current_exception();
+  }
+  {
+    std::lock_guard lock(mutex_);
+    task.done = true;
+  }
+  changed_.notify_all();
+}
+
+// CLASS BIGINTEGER
+
+class BigDivisor;
+class DecimalReader;
+template <size_t Bits>
+class FixedBigInteger;
+template <char... Chars>
+struct IntegerLiteral;
+
+class BigInteger {
+ public:
+  BigInteger(): sign_(sign::ZERO) {};
+  BigInteger(long long num);
+  // Truncates toward zero like a cast to an integer type, the number must be finite
+  template <std::floating_point Float>
+  explicit BigInteger(Float number);
+  // The whole string must be a decimal number with an optional leading '-', otherwise throws
+  // std::invalid_argument
+  BigInteger(const std::string& str);
+  BigInteger(const BigInteger& other) = default;
+  BigInteger(BigInteger&& other) noexcept = default;
+  ~BigInteger() = default;
+
+  BigInteger& operator=(const BigInteger& other) = default;
+  BigInteger& operator=(BigInteger&& other) noexcept = default;
+
+  BigInteger& operator+=(const BigInteger& other);
+  BigInteger& operator-=(const BigInteger& other);
+  BigInteger& operator*=(const BigInteger& other);
+  BigInteger& operator/=(const BigInteger& other);
+  BigInteger& operator%=(const BigInteger& other);
+
+  // Fused multiply-accumulate: *this += first * second and *this -= first * second
+  BigInteger& addmul(const BigInteger& first, const BigInteger& second);
+  BigInteger& submul(const BigInteger& first, const BigInteger& second);
+
+  BigInteger operator-() const&;
+  BigInteger operator-() &&;
+  BigInteger& operator++();
+  BigInteger operator++(int);
+  BigInteger& operator--();
+  BigInteger operator--(int);
+  explicit operator bool() const;
+  // Narrowing conversion, false if the value does not fit into long long
+  bool toLongLong(long long& result) const;
+  // Correctly rounded (to nearest, ties to even) floating point value
+  double toDouble() const;
+  long double toLongDouble() const;
+
+  std::string toString() const;
+  // Upper bound on the length of toString(), enough for to_chars() to write into directly
+  size_t stringLengthBound() const;
+
+  // Opt-in parallel execution: with more than one thread, multiplications of operands from the threshold
+  // (in limbs) up, and the divisions and radix conversions built on them, split independent work across
+  // a shared pool. Must not be changed while other threads are computing.
+  static void setThreads(unsigned count);
+  static void setParallelThreshold(size_t limbs);
+
+ private:
+  // Magnitudes are stored as base 2^32 limbs, least significant first
+  using limb = mpn::limb;
+  using double_limb = mpn::double_limb;
+
+  static const int LIMB_BITS = mpn::LIMB_BITS;
+  static const double_limb BASE = double_limb(1) << LIMB_BITS;
+
+  // Decimal conversion works in chunks of SIZE digits
+  static const limb DECIMAL_BASE = 1'000'000'000;
+  static const int SIZE = 9;
+
+  // Magnitude size (in limbs) up to which radix conversion runs chunk by chunk, larger values are
+  // split recursively around cached powers 10^(SIZE * 2^level)
+  static const size_t DECIMAL_CONVERSION_THRESHOLD = 60;
+
+  // Operand sizes (in limbs) at which multiplication switches to the next tier
+  static const size_t KARATSUBA_THRESHOLD = 40;
+  static const size_t TOOM3_THRESHOLD = 160;
+  static const size_t NTT_THRESHOLD = 1000;
+
+  // Two NTT-friendly primes, their product bounds every convolution coefficient of 16-bit pieces
+  // as long as the product fits into NTT_MAX_SIZE limbs
+  static const unsigned NTT_MODULUS_1 = 167'772'161;
+  static const unsigned NTT_MODULUS_2 = 469'762'049;
+  static const size_t NTT_MAX_SIZE = size_t(1) << 24;
+  // Fewest butterflies per level given to one thread in a parallel transform
+  static const size_t NTT_PARALLEL_GRAIN = size_t(1) << 14;
+
+  // Divider size (in limbs) at which division switches to Burnikel-Ziegler recursion
+  static const size_t BURNIKEL_ZIEGLER_THRESHOLD = 150;
+
+  // Modulus size (in limbs) up to which powmod() uses Montgomery multiplication
+  static const size_t MONTGOMERY_THRESHOLD = 400;
+
+  // Operand size (in limbs) from which gcd() reduces by half-GCD recursion instead of Lehmer steps
+  static const size_t HALF_GCD_THRESHOLD = 120;
+
+  enum class sign : int8_t {
+    NEGATIVE = -1,
+    ZERO = 0,
+    POSITIVE = 1
+  };
+
+  LimbVector digits_;
+  BigInteger::sign sign_;
+
+  void remove_leading_zeroes();
+  void multiply_add(limb multiplier, limb addend);
+  void add_magnitude(const BigInteger& other);
+  void subtract_magnitude(const BigInteger& other);
+  BigInteger& add_product(const BigInteger& first, const BigInteger& second, int product_sign);
+  void set_magnitude(LimbVector& limbs, sign new_sign);
+  static BigInteger limbs_slice(const BigInteger& number, size_t begin, size_t end);
+  static BigInteger shift_limbs(const BigInteger& number, size_t count);
+  static BigInteger shift_bits(const BigInteger& number, size_t count);
+  size_t bit_length() const;
+  limb divide_by_limb(limb divider);
+
+  static int compare_limbs(const limb* first, size_t first_size, const limb* second, size_t second_size);
+  static void add_limbs(limb* result, size_t result_size, const limb* other, size_t other_size);
+  static void subtract_limbs(limb* result, size_t result_size, const limb* other, size_t other_size);
+  static void multiply_schoolbook(const limb* first, size_t first_size, const limb* second, size_t second_size, limb* result);
+  static void multiply_karatsuba(const limb* first, size_t first_size, const limb* second, size_t second_size, limb* result);
+  static void multiply_toom3(const limb* first, size_t first_size, const limb* second, size_t second_size, limb* result);
+  static void interpolate_toom3(BigInteger& r0, BigInteger& r1, BigInteger& r_minus_one, BigInteger& r_minus_two, BigInteger& r4, size_t part, limb* result, size_t result_size);
+  static void multiply_ntt(const limb* first, size_t first_size, const limb* second, size_t second_size, limb* result);
+  static void multiply_limbs(const limb* first, size_t first_size, const limb* second, size_t second_size, limb* result);
+  static void square_schoolbook(const limb* value, size_t size, limb* result);
+  static void square_karatsuba(const limb* value, size_t size, limb* result);
+  static void square_toom3(const limb* value, size_t size, limb* result);
+  static void square_limbs(const limb* value, size_t size, limb* result);
+
+  static bool run_parallel(size_t size);
+  template <class Function>
+  static BigInteger with_scratch(Function&& function);
+  template <class... Tasks>
+  static void run_tasks(bool parallel, Tasks&&... tasks);
+
+  static void divide_knuth(const limb* dividend, size_t dividend_size, const limb* divider, size_t divider_size, limb* quotient, limb* remainder);
+  static void divide_normalized(limb* current, size_t current_size, const limb* normalized, size_t divider_size, limb* quotient);
+  static void divide_quadratic(const BigInteger& dividend, const BigInteger& divider, BigInteger& quotient, BigInteger& remainder);
+  static void divide_two_by_one(const BigInteger& dividend, const BigInteger& divider, size_t size, BigInteger& quotient, BigInteger& remainder);
+  static void divide_three_by_two(const BigInteger& high, const BigInteger& low, const BigInteger& divider, const BigInteger& divider_high, const BigInteger& divider_low, size_t size, BigInteger& quotient, BigInteger& remainder);
+  static void divide_recursive(const BigInteger& dividend, const BigInteger& divider, BigInteger& quotient, BigInteger& remainder);
+  static void divide(const BigInteger& dividend, const BigInteger& divider, BigInteger* quotient, BigInteger* remainder);
+
+  static std::vector<bool> exponent_bits(const BigInteger& pow);
+
+  template <class Float>
+  Float round_to_floating(size_t position, bool sticky) const;
+  template <class Float>
+  Float to_floating() const;
+  template <class Float>
+  static Float quotient_to_floating(const BigInteger& numerator, const BigInteger& denominator);
+
+  struct GcdMatrix;
+  static double_limb gcd_binary(double_limb first, double_limb second);
+  static bool lehmer_cofactors(const BigInteger& a, const BigInteger& b, limb* cofactors);
+  static bool combine_limbs(const BigInteger& first, limb first_factor, const BigInteger& second, limb second_factor, BigInteger& result);
+  static void apply_gcd_matrix(GcdMatrix& matrix, BigInteger& a, BigInteger& b, size_t shift, const BigInteger& a_high, const BigInteger& b_high);
+  static void multiply_gcd_matrices(const GcdMatrix& first, GcdMatrix& second);
+  static void gcd_step(BigInteger& a, BigInteger& b, GcdMatrix* matrix);
+  static void half_gcd(BigInteger& a, BigInteger& b, GcdMatrix& matrix);
+  static void gcd_reduce(BigInteger& a, BigInteger& b, GcdMatrix* matrix);
+
+  static const BigInteger& decimal_power(size_t level);
+  static const BigDivisor& decimal_divisor(size_t level);
+  static void write_decimal_chunk(limb chunk, char* out);
+  static char* write_decimal(const BigInteger& value, char* out, size_t width);
+  static char* write_decimal_parallel(const BigInteger& value, char* out, size_t width, const std::vector<const BigDivisor*>& divisors);
+  static void read_decimal(const char* first, size_t length, BigInteger& value);
+  static void read_decimal_parallel(const char* first, size_t length, BigInteger& value, const std::vector<const BigInteger*>& powers);
+  template <class Sink>
+  static void write_decimal_chunked(const BigInteger& value, size_t width, Sink& sink);
+
+  static limb montgomery_inverse(limb value);
+  static void montgomery_reduce(limb* value, const limb* modulus, size_t size, limb inverse);
+
+  static unsigned long long modular_power(unsigned long long value, unsigned long long pow, unsigned long long modulus);
+  template <unsigned Modulus, unsigned Root>
+  static void number_theoretic_transform(std::vector<unsigned>& values, bool inverse, bool parallel);
+  template <unsigned Modulus, unsigned Root>
+  static std::vector<unsigned> convolve(const std::vector<unsigned>& first, const std::vector<unsigned>& second, size_t size, bool square, bool parallel);
+
+  friend bool operator==(const BigInteger& first, const BigInteger& second);
+  friend bool operator<(const BigInteger& first, const BigInteger& second);
+  friend std::strong_ordering operator<=>(const BigInteger& first, const BigInteger& second);
+  friend double frexp(const BigInteger& value, long long* exponent);
+
+  friend std::pair<BigInteger, BigInteger> divmod(const BigInteger& dividend, const BigInteger& divider);
+  friend BigInteger square(const BigInteger& value);
+  friend BigInteger power(const BigInteger& value, const BigInteger& pow);
+  friend BigInteger powmod(const BigInteger& value, const BigInteger& pow, const BigInteger& modulus);
+  friend BigInteger gcd(const BigInteger& first, const BigInteger& second);
+  friend BigInteger gcdext(const BigInteger& first, const BigInteger& second, BigInteger& x, BigInteger& y);
+
+  friend std::to_chars_result to_chars(char* first, char* last, const BigInteger& value);
+  friend std::from_chars_result from_chars(const char* first, const char* last, BigInteger& value);
+  template <class Sink>
+  friend void to_chars_chunked(const BigInteger& value, Sink&& sink);
+
+  friend class BigDivisor;
+  friend class DecimalReader;
+  friend class Rational;
+  template <size_t Bits>
+  friend class FixedBigInteger;
+  template <char... Chars>
+  friend struct IntegerLiteral;
+};
+
+// Declaration of operators
+
+BigInteger operator+(const BigInteger& first, const BigInteger& second);
+BigInteger operator-(const BigInteger& first, const BigInteger& second);
+BigInteger operator*(const BigInteger& first, const BigInteger& second);
+BigInteger operator/(const BigInteger& first, const BigInteger& second);
+BigInteger operator%(const BigInteger& first, const BigInteger& second);
+
+// Overloads for expiring operands, the result reuses their storage
+BigInteger operator+(BigInteger&& first, const BigInteger& second);
+BigInteger operator+(const BigInteger& first, BigInteger&& second);
+BigInteger operator+(BigInteger&& first, BigInteger&& second);
+BigInteger operator-(BigInteger&& first, const BigInteger& second);
+BigInteger operator*(BigInteger&& first, const BigInteger& second);
+BigInteger operator*(const BigInteger& first, BigInteger&& second);
+BigInteger operator*(BigInteger&& first, BigInteger&& second);
+BigInteger operator/(BigInteger&& first, const BigInteger& second);
+BigInteger operator%(BigInteger&& first, const BigInteger& second);
+
+std::pair<BigInteger, BigInteger> divmod(const BigInteger& dividend, const BigInteger& divider);
+BigInteger square(const BigInteger& value);
+// Negative exponents throw std::domain_error. The signed overload keeps a negative int from
+// converting to a huge unsigned exponent.
+BigInteger power(const BigInteger& value, unsigned long long pow);
+template <std::signed_integral Exponent>
+BigInteger power(const BigInteger& value, Exponent pow);
+BigInteger power(const BigInteger& value, const BigInteger& pow);
+// value^pow mod |modulus| in [0, |modulus|). A negative pow raises the modular inverse of value and
+// throws std::domain_error when value has none, a zero modulus throws std::domain_error as well.
+BigInteger powmod(const BigInteger& value, const BigInteger& pow, const BigInteger& modulus);
+
+// Nonnegative greatest common divisor and least common multiple
+BigInteger gcd(const BigInteger& first, const BigInteger& second);
+BigInteger lcm(const BigInteger& first, const BigInteger& second);
+// Returns gcd(first, second) and sets x, y with first * x + second * y == gcd, |x| <= |second| / (2 * gcd)
+BigInteger gcdext(const BigInteger& first, const BigInteger& second, BigInteger& x, BigInteger& y);
+
+// Splits the value into a mantissa with magnitude in [0.5, 1) and a power of two like std::frexp, the
+// mantissa is rounded from the leading 96 bits and is only an approximation for longer values
+double frexp(const BigInteger& value, long long* exponent);
+
+bool operator==(const BigInteger& first, const BigInteger& second);
+bool operator<(const BigInteger& first, const BigInteger& second);
+bool operator!=(const BigInteger& first, const BigInteger& second);
+bool operator>=(const BigInteger& first, const BigInteger& second);
+bool operator>(const BigInteger& first, const BigInteger& second);
+bool operator<=(const BigInteger& first, const BigInteger& second);
+std::strong_ordering operator<=>(const BigInteger& first, const BigInteger& second);
+
+std::ostream& operator<<(std::ostream& out, const BigInteger& big_integer);
+std::istream& operator>>(std::istream& in, BigInteger& big_integer);
+
+// Decimal conversion into and out of caller-provided buffers, with the semantics of std::to_chars
+// and std::from_chars (an optional leading '-' is accepted)
+std::to_chars_result to_chars(char* first, char* last, const BigInteger& value);
+std::from_chars_result from_chars(const char* first, const char* last, BigInteger& value);
+// Hands the decimal form of value to sink(const char* data, size_t size) in pieces of bounded size,
+// so a huge value reaches a file without a full-length string
+template <class Sink>
+void to_chars_chunked(const BigInteger& value, Sink&& sink);
+
+// Integer literal of any length (decimal, 0x hexadecimal, 0b binary or 0 octal, with ' separators),
+// its limbs are computed at compile time
+template <char... Chars>
+BigInteger operator""_bi();
+
+// Additional functions
+
+BigInteger abs(const BigInteger& bi) {
+  if (bi < 0) {
+    return -bi;
+  }
+  return bi;
+}
+
+double frexp(const BigInteger& value, long long* exponent) {
+  if (value.sign_ == BigInteger::sign::ZERO) {
+    *exponent = 0;
+    return 0;
+  }
+
+  size_t size = value.digits_.size();
+  size_t begin = (size > 3) ? size - 3 : 0;
+  double leading = 0;
+  for (size_t i = size; i-- > begin;) {
+    leading = leading * BigInteger::BASE + value.digits_[i];
+  }
+
+  int leading_exponent;
+  double mantissa = std::frexp(leading, &leading_exponent);
+  *exponent = leading_exponent + static_cast<long long>(begin) * BigInteger::LIMB_BITS;
+  return (value.sign_ == BigInteger::sign::NEGATIVE) ? -mantissa : mantissa;
+}
+
+void BigInteger::remove_leading_zeroes() {
+  while (std::as_const(digits_).back() == 0 && digits_.size() > 1) {
+    digits_.pop_back();
+  }
+}
+
+// Left-to-right sliding window over the exponent bits (least significant first)
+template <class Multiply, class Square>
+BigInteger power_sliding_window(const BigInteger& base, const std::vector<bool>& bits, Multiply multiply, Square square) {
+  size_t window = 1;
+  while (window < 6 && bits.size() > (size_t(1) << (2 * window + 1))) {
+    ++window;
+  }
+
+  // Odd powers base^1, base^3, ..., base^(2^window - 1)
+  std::vector<BigInteger> powers(size_t(1) << (window - 1), base);
+  BigInteger base_square = base;
+  square(base_square);
+  for (size_t i = 1; i < powers.size(); ++i) {
+    powers[i] = powers[i - 1];
+    multiply(powers[i], base_square);
+  }
+
+  BigInteger result;
+  bool started = false;
+  for (size_t i = bits.size(); i > 0;) {
+    if (!bits[i - 1]) {
+      square(result);
+      --i;
+      continue;
+    }
+
+    size_t low = (i > window) ? i - window : 0;
+    while (!bits[low]) {
+      ++low;
+    }
+    size_t value = 0;
+    for (size_t j = i; j > low; --j) {
+      value = 2 * value + bits[j - 1];
+    }
+
+    if (started) {
+      for (size_t j = low; j < i; ++j) {
+        square(result);
+      }
+      multiply(result, powers[value / 2]);
+    } else {
+      result = powers[value / 2];
+      started = true;
+    }
+    i = low;
+  }
+  return result;
+}
+
+BigInteger square(const BigInteger& value) {
+  if (value.sign_ == BigInteger::sign::ZERO) {
+    return 0;
+  }
+  BigInteger result;
+  LimbVector limbs(2 * value.digits_.size());
+  BigInteger::square_limbs(value.digits_.data(), value.digits_.size(), limbs.data());
+  result.set_magnitude(limbs, BigInteger::sign::POSITIVE);
+  return result;
+}
+
+BigInteger power(const BigInteger& value, unsigned long long pow) {
+  if (pow == 0) {
+    return 1;
+  }
+  std::vector<bool> bits;
+  for (; pow > 0; pow >>= 1) {
+    bits.push_back(pow & 1);
+  }
+  auto multiply = [](BigInteger& target, const BigInteger& other) { target *= other; };
+  auto square_in_place = [](BigInteger& target) { target = square(target); };
+  return power_sliding_window(value, bits, multiply, square_in_place);
+}
+
+template <std::signed_integral Exponent>
+BigInteger power(const BigInteger& value, Exponent pow) {
+  if (pow < 0) {
+    throw std::domain_error("power: negative exponent");
+  }
+  return power(value, static_cast<unsigned long long>(pow));
+}
+
+BigInteger power(const BigInteger& value, const BigInteger& pow) {
+  if (pow.sign_ == BigInteger::sign::NEGATIVE) {
+    throw std::domain_error("power: negative exponent");
+  }
+  if (pow.sign_ == BigInteger::sign::ZERO) {
+    return 1;
+  }
+  auto multiply = [](BigInteger& target, const BigInteger& other) { target *= other; };
+  auto square_in_place = [](BigInteger& target) { target = square(target); };
+  return power_sliding_window(value, BigInteger::exponent_bits(pow), multiply, square_in_place);
+}
+
+// Exponent bits, least significant first
+std::vector<bool> BigInteger::exponent_bits(const BigInteger& pow) {
+  std::vector<bool> bits;
+  for (limb digit : pow.digits_) {
+    for (int j = 0; j < LIMB_BITS; ++j) {
+      bits.push_back((digit >> j) & 1);
+    }
+  }
+  while (!bits.empty() && !bits.back()) {
+    bits.pop_back();
+  }
+  return bits;
+}
+
+void BigInteger::set_magnitude(LimbVector& limbs, sign new_sign) {
+  digits_.swap(limbs);
+  if (digits_.empty()) {
+    digits_.push_back(0);
+  }
+  remove_leading_zeroes();
+  sign_ = (std::as_const(digits_).back() == 0) ? sign::ZERO : new_sign;
+}
+
+// Magnitude of (number / BASE^begin) % BASE^(end - begin)
+BigInteger BigInteger::limbs_slice(const BigInteger& number, size_t begin, size_t end) {
+  begin = std::min(begin, number.digits_.size());
+  end = std::min(end, number.digits_.size());
+  LimbVector limbs(number.digits_.begin() + begin, number.digits_.begin() + end);
+  BigInteger slice;
+  slice.set_magnitude(limbs, sign::POSITIVE);
+  return slice;
+}
+
+// number * BASE^count
+BigInteger BigInteger::shift_limbs(const BigInteger& number, size_t count) {
+  if (number.sign_ == sign::ZERO) {
+    return number;
+  }
+  BigInteger shifted;
+  shifted.digits_.assign(count + number.digits_.size(), 0);
+  std::copy(number.digits_.begin(), number.digits_.end(), shifted.digits_.begin() + count);
+  shifted.sign_ = number.sign_;
+  return shifted;
+}
+
+// number * 2^count
+BigInteger BigInteger::shift_bits(const BigInteger& number, size_t count) {
+  BigInteger shifted = shift_limbs(number, count / LIMB_BITS);
+  if (shifted.sign_ != sign::ZERO) {
+    shifted.multiply_add(limb(1) << (count % LIMB_BITS), 0);
+  }
+  return shifted;
+}
+
+size_t BigInteger::bit_length() const {
+  if (sign_ == sign::ZERO) {
+    return 0;
+  }
+  return digits_.size() * LIMB_BITS - std::countl_zero(digits_.back());
+}
+
+// Magnitude becomes |*this| * multiplier + addend
+void BigInteger::multiply_add(limb multiplier, limb addend) {
+  limb carry = mpn::mul_1(digits_.data(), digits_.data(), digits_.size(), multiplier);
+  carry += mpn::add_1(digits_.data(), digits_.data(), digits_.size(), addend);
+  if (carry > 0) {
+    digits_.push_back(carry);
+  }
+  remove_leading_zeroes();
+}
+
+void BigInteger::add_magnitude(const BigInteger& other) {
+  digits_.resize(std::max(digits_.size(), other.digits_.size()) + 1, 0);
+  add_limbs(digits_.data(), digits_.size(), other.digits_.data(), other.digits_.size());
+  remove_leading_zeroes();
+}
+
+void BigInteger::subtract_magnitude(const BigInteger& other) {
+  int comparison = compare_limbs(std::as_const(digits_).data(), digits_.size(), other.digits_.data(), other.digits_.size());
+  if (comparison == 0) {
+    *this = 0;
+    return;
+  }
+
+  if (comparison > 0) {
+    subtract_limbs(digits_.data(), digits_.size(), other.digits_.data(), other.digits_.size());
+  } else {
+    LimbVector difference = other.digits_;
+    subtract_limbs(difference.data(), difference.size(), std::as_const(digits_).data(), digits_.size());
+    digits_.swap(difference);
+    sign_ = (sign_ == sign::POSITIVE) ? sign::NEGATIVE : sign::POSITIVE;
+  }
+  remove_leading_zeroes();
+}
+
+BigInteger::limb BigInteger::divide_by_limb(limb divider) {
+  limb remainder = mpn::divrem_1(digits_.data(), digits_.data(), digits_.size(), divider);
+  remove_leading_zeroes();
+  if (digits_.back() == 0) {
+    sign_ = sign::ZERO;
+  }
+  return remainder;
+}
+
+// Multiplication engine
+
+void BigInteger::add_limbs(limb* result, size_t result_size, const limb* other, size_t other_size) {
+  other_size = std::min(other_size, result_size);
+  limb carry = mpn::add_n(result, result, other, other_size);
+  mpn::add_1(result + other_size, result + other_size, result_size - other_size, carry);
+}
+
+void BigInteger::subtract_limbs(limb* result, size_t result_size, const limb* other, size_t other_size) {
+  other_size = std::min(other_size, result_size);
+  limb borrow = mpn::sub_n(result, result, other, other_size);
+  mpn::sub_1(result + other_size, result + other_size, result_size - other_size, borrow);
+}
+
+// Runs function with its temporaries in the scratch arena, the result is copied out to the caller's
+// memory resource (limb by limb, a shared block would keep the arena alive)
+template <class Function>
+BigInteger BigInteger::with_scratch(Function&& function) {
+  std::pmr::memory_resource* outer = MemoryScope::resource();
+  BigInteger result;
+  {
+    ScratchScope scratch;
+    const BigInteger value = function();
+    MemoryScope caller(outer);
+    result.digits_.assign(value.digits_.begin(), value.digits_.end());
+    result.sign_ = value.sign_;
+  }
+  return result;
+}
+
+// Parallel execution
+
+void BigInteger::setThreads(unsigned count) {
+  ThreadPool::instance().setThreads(count);
+}
+
+void BigInteger::setParallelThreshold(size_t limbs) {
+  ThreadPool::instance().setThreshold(limbs);
+}
+
+// Whether work on operands of size limbs is split across the pool
+bool BigInteger::run_parallel(size_t size) {
+  ThreadPool& pool = ThreadPool::instance();
+  return pool.threads() > 1 && size >= pool.threshold();
+}
+
+// Runs independent tasks, on the pool when parallel and one after another otherwise
+template <class... Tasks>
+void BigInteger::run_tasks(bool parallel, Tasks&&... tasks) {
+  if (parallel) {
+    ThreadPool::instance().invoke(std::forward<Tasks>(tasks)...);
+  } else {
+    (tasks(), ...);
+  }
+}
+
+void BigInteger::multiply_schoolbook(const limb* first, size_t first_size, const limb* second, size_t second_size, limb* result) {
+  std::fill(result, result + first_size + second_size, 0);
+  for (size_t i = 0; i < first_size; ++i) {
+    result[i + second_size] = mpn::addmul_1(result + i, second, second_size, first[i]);
+  }
+}
+
+// Every cross product is computed once and doubled, then the squares of the limbs are added
+void BigInteger::square_schoolbook(const limb* value, size_t size, limb* result) {
+  std::fill(result, result + 2 * size, 0);
+  for (size_t i = 0; i < size; ++i) {
+    result[i + size] = mpn::addmul_1(result + 2 * i + 1, value + i + 1, size - i - 1, value[i]);
+  }
+
+  limb carry = 0;
+  for (size_t i = 0; i < 2 * size; ++i) {
+    limb top = result[i] >> (LIMB_BITS - 1);
+    result[i] = (result[i] << 1) | carry;
+    carry = top;
+  }
+
+  double_limb square_carry = 0;
+  for (size_t i = 0; i < size; ++i) {
+    double_limb number = static_cast<double_limb>(value[i]) * value[i] + result[2 * i] + square_carry;
+    result[2 * i] = static_cast<limb>(number);
+    number = (number >> LIMB_BITS) + result[2 * i + 1];
+    result[2 * i + 1] = static_cast<limb>(number);
+    square_carry = number >> LIMB_BITS;
+  }
+}
+
+// Requires first_size >= second_size > first_size / 2
+void BigInteger::multiply_karatsuba(const limb* first, size_t first_size, const limb* second, size_t second_size, limb* result) {
+  size_t half = first_size / 2;
+  size_t high_first = first_size - half;
+  size_t high_second = second_size - half;
+
+  LimbVector first_sum(first, first + half);
+  first_sum.resize(high_first + 1, 0);
+  add_limbs(first_sum.data(), first_sum.size(), first + half, high_first);
+
+  LimbVector second_sum(second, second + half);
+  second_sum.resize(std::max(half, high_second) + 1, 0);
+  add_limbs(second_sum.data(), second_sum.size(), second + half, high_second);
+
+  LimbVector middle(first_sum.size() + second_sum.size());
+  run_tasks(run_parallel(second_size),
+      [&] { multiply_limbs(first_sum.data(), first_sum.size(), second_sum.data(), second_sum.size(), middle.data()); },
+      [&] { multiply_limbs(first, half, second, half, result); },
+      [&] { multiply_limbs(first + half, high_first, second + half, high_second, result + 2 * half); });
+  subtract_limbs(middle.data(), middle.size(), result, 2 * half);
+  subtract_limbs(middle.data(), middle.size(), result + 2 * half, high_first + high_second);
+
+  size_t middle_size = middle.size();
+  while (middle_size > 0 && middle[middle_size - 1] == 0) {
+    --middle_size;
+  }
+  add_limbs(result + half, first_size + second_size - half, middle.data(), middle_size);
+}
+
+// Toom-3 with Bodrato's interpolation sequence, evaluated at 0, 1, -1, -2 and infinity
+void BigInteger::multiply_toom3(const limb* first, size_t first_size, const limb* second, size_t second_size, limb* result) {
+  size_t part = (first_size + 2) / 3;
+
+  BigInteger first_number;
+  first_number.digits_.assign(first, first + first_size);
+  BigInteger second_number;
+  second_number.digits_.assign(second, second + second_size);
+
+  BigInteger a0 = limbs_slice(first_number, part * 0, part * 1);
+  BigInteger a1 = limbs_slice(first_number, part * 1, part * 2);
+  BigInteger a2 = limbs_slice(first_number, part * 2, part * 3);
+  BigInteger b0 = limbs_slice(second_number, part * 0, part * 1);
+  BigInteger b1 = limbs_slice(second_number, part * 1, part * 2);
+  BigInteger b2 = limbs_slice(second_number, part * 2, part * 3);
+
+  BigInteger a_even = a0 + a2;
+  BigInteger b_even = b0 + b2;
+  BigInteger a_one = a_even + a1;
+  BigInteger b_one = b_even + b1;
+  BigInteger a_minus_one = a_even - a1;
+  BigInteger b_minus_one = b_even - b1;
+  BigInteger a_minus_two = (a_minus_one + a2) * 2 - a0;
+  BigInteger b_minus_two = (b_minus_one + b2) * 2 - b0;
+
+  BigInteger r0, r1, r_minus_one, r_minus_two, r4;
+  run_tasks(run_parallel(second_size),
+      [&] { r1 = a_one * b_one; },
+      [&] { r_minus_one = a_minus_one * b_minus_one; },
+      [&] { r_minus_two = a_minus_two * b_minus_two; },
+      [&] { r0 = a0 * b0; },
+      [&] { r4 = a2 * b2; });
+
+  interpolate_toom3(r0, r1, r_minus_one, r_minus_two, r4, part, result, first_size + second_size);
+}
+
+// Bodrato's interpolation, the coefficients are accumulated into result
+void BigInteger::interpolate_toom3(BigInteger& r0, BigInteger& r1, BigInteger& r_minus_one, BigInteger& r_minus_two, BigInteger& r4, size_t part, limb* result, size_t result_size) {
+  BigInteger r3 = r_minus_two - r1;
+  r3.divide_by_limb(3);
+  r1 -= r_minus_one;
+  r1.divide_by_limb(2);
+  BigInteger r2 = r_minus_one - r0;
+  r3 = r2 - r3;
+  r3.divide_by_limb(2);
+  r3 += r4 * 2;
+  r2 += r1;
+  r2 -= r4;
+  r1 -= r3;
+
+  std::fill(result, result + result_size, 0);
+  const BigInteger* coefficients[] = {&r0, &r1, &r2, &r3, &r4};
+  for (size_t i = 0; i < 5 && part * i < result_size; ++i) {
+    if (coefficients[i]->sign_ != sign::ZERO) {
+      add_limbs(result + part * i, result_size - part * i, coefficients[i]->digits_.data(), coefficients[i]->digits_.size());
+    }
+  }
+}
+
+unsigned long long BigInteger::modular_power(unsigned long long value, unsigned long long pow, unsigned long long modulus) {
+  unsigned long long result = 1;
+  value %= modulus;
+  while (pow > 0) {
+    if (pow & 1) {
+      result = result * value % modulus;
+    }
+    value = value * value % modulus;
+    pow >>= 1;
+  }
+  return result;
+}
+
+template <unsigned Modulus, unsigned Root>
+void BigInteger::number_theoretic_transform(std::vector<unsigned>& values, bool inverse, bool parallel) {
+  size_t size = values.size();
+  for (size_t i = 1, j = 0; i < size; ++i) {
+    size_t bit = size >> 1;
+    for (; j & bit; bit >>= 1) {
+      j ^= bit;
+    }
+    j ^= bit;
+    if (i < j) {
+      std::swap(values[i], values[j]);
+    }
+  }
+
+  // Runs work(begin, end) over [0, count), cut into pieces for the pool when parallel
+  auto split = [parallel](size_t count, auto&& work) {
+    size_t pieces = parallel ? std::min<size_t>(count / NTT_PARALLEL_GRAIN, 4 * ThreadPool::instance().threads()) : 1;
+    if (pieces <= 1) {
+      work(0, count);
+      return;
+    }
+    ThreadPool::instance().forEach(0, pieces, [&](size_t piece) {
+      work(count * piece / pieces, count * (piece + 1) / pieces);
+    });
+  };
+
+  // Twiddles of every level are taken from the largest one, with the quotients floor(root * 2^32 /
+  // Modulus) for Shoup's multiplication in the butterflies
+  size_t top = size / 2;
+  unsigned long long step = modular_power(Root, (Modulus - 1) / size, Modulus);
+  if (inverse) {
+    step = modular_power(step, Modulus - 2, Modulus);
+  }
+  std::vector<unsigned> roots(top), quotients(top);
+  split(top, [&](size_t begin, size_t end) {
+    unsigned long long root = modular_power(step, begin, Modulus);
+    for (size_t k = begin; k < end; ++k) {
+      roots[k] = root;
+      quotients[k] = (static_cast<double_limb>(root) << 32) / Modulus;
+      root = root * step % Modulus;
+    }
+  });
+  std::vector<unsigned> level_roots(top), level_quotients(top);
+  for (size_t length = 2; length <= size; length <<= 1) {
+    size_t half = length / 2;
+    size_t stride = size / length;
+    split(half, [&](size_t begin, size_t end) {
+      for (size_t k = begin; k < end; ++k) {
+        level_roots[k] = roots[k * stride];
+        level_quotients[k] = quotients[k * stride];
+      }
+    });
+    // Butterfly j of the level sits in block j / half at offset j % half
+    split(top, [&](size_t begin, size_t end) {
+      size_t i = begin / half * length;
+      size_t k = begin % half;
+      while (begin < end) {
+        size_t count = std::min(half - k, end - begin);
+        mpn::ntt_butterflies(values.data() + i + k, values.data() + i + half + k, level_roots.data() + k, level_quotients.data() + k, count, Modulus);
+        begin += count;
+        i += length;
+        k = 0;
+      }
+    });
+  }
+
+  if (inverse) {
+    unsigned long long size_inverse = modular_power(size, Modulus - 2, Modulus);
+    split(size, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        values[i] = values[i] * size_inverse % Modulus;
+      }
+    });
+  }
+}
+
+template <unsigned Modulus, unsigned Root>
+std::vector<unsigned> BigInteger::convolve(const std::vector<unsigned>& first, const std::vector<unsigned>& second, size_t size, bool square, bool parallel) {
+  std::vector<unsigned> first_values(first);
+  first_values.resize(size, 0);
+
+  if (square) {
+    number_theoretic_transform<Modulus, Root>(first_values, false, parallel);
+    for (unsigned& value : first_values) {
+      value = static_cast<double_limb>(value) * value % Modulus;
+    }
+  } else {
+    std::vector<unsigned> second_values(second);
+    second_values.resize(size, 0);
+    run_tasks(parallel,
+        [&] { number_theoretic_transform<Modulus, Root>(first_values, false, parallel); },
+        [&] { number_theoretic_transform<Modulus, Root>(second_values, false, parallel); });
+    for (size_t i = 0; i < size; ++i) {
+      first_values[i] = static_cast<double_limb>(first_values[i]) * second_values[i] % Modulus;
+    }
+  }
+
+  number_theoretic_transform<Modulus, Root>(first_values, true, parallel);
+  return first_values;
+}
+
+// Two-prime NTT over 16-bit pieces of the limbs, coefficients are restored with Garner's CRT
+void BigInteger::multiply_ntt(const limb* first, size_t first_size, const limb* second, size_t second_size, limb* result) {
+  size_t result_size = first_size + second_size;
+  size_t size = 1;
+  while (size < 2 * result_size) {
+    size <<= 1;
+  }
+  bool square = (first_size == second_size) && (first == second || std::equal(first, first + first_size, second));
+
+  auto split = [](const limb* limbs, size_t limbs_size) {
+    std::vector<unsigned> pieces(2 * limbs_size);
+    for (size_t i = 0; i < limbs_size; ++i) {
+      pieces[2 * i] = limbs[i] & 0xFFFF;
+      pieces[2 * i + 1] = limbs[i] >> 16;
+    }
+    return pieces;
+  };
+  std::vector<unsigned> first_pieces = split(first, first_size);
+  std::vector<unsigned> second_pieces;
+  if (!square) {
+    second_pieces = split(second, second_size);
+  }
+
+  bool parallel = run_parallel(second_size);
+  std::vector<unsigned> first_residues, second_residues;
+  run_tasks(parallel,
+      [&] { first_residues = convolve<NTT_MODULUS_1, 3>(first_pieces, second_pieces, size, square, parallel); },
+      [&] { second_residues = convolve<NTT_MODULUS_2, 3>(first_pieces, second_pieces, size, square, parallel); });
+
+  const double_limb first_inverse = modular_power(NTT_MODULUS_1, NTT_MODULUS_2 - 2, NTT_MODULUS_2);
+
+  double_limb carry = 0;
+  for (size_t i = 0; i < 2 * result_size; ++i) {
+    double_limb r1 = first_residues[i];
+    double_limb r2 = second_residues[i];
+    double_limb coefficient = r1 + NTT_MODULUS_1 * ((r2 + NTT_MODULUS_2 - r1) * first_inverse % NTT_MODULUS_2);
+
+    carry += coefficient;
+    if (i % 2 == 0) {
+      result[i / 2] = carry & 0xFFFF;
+    } else {
+      result[i / 2] |= static_cast<limb>(carry & 0xFFFF) << 16;
+    }
+    carry >>= 16;
+  }
+}
+
+void BigInteger::multiply_limbs(const limb* first, size_t first_size, const limb* second, size_t second_size, limb* result) {
+  if (first_size < second_size) {
+    std::swap(first, second);
+    std::swap(first_size, second_size);
+  }
+
+  if (second_size < KARATSUBA_THRESHOLD) {
+    multiply_schoolbook(first, first_size, second, second_size, result);
+    return;
+  }
+
+  if (second_size >= NTT_THRESHOLD && first_size + second_size <= NTT_MAX_SIZE) {
+    multiply_ntt(first, first_size, second, second_size, result);
+    return;
+  }
+
+  if (2 * second_size <= first_size) {
+    // Unbalanced operands: multiply the longer one chunk by chunk
+    std::fill(result, result + first_size + second_size, 0);
+    LimbVector chunk(2 * second_size);
+    for (size_t i = 0; i < first_size; i += second_size) {
+      size_t chunk_size = std::min(second_size, first_size - i);
+      multiply_limbs(first + i, chunk_size, second, second_size, chunk.data());
+      add_limbs(result + i, first_size + second_size - i, chunk.data(), chunk_size + second_size);
+    }
+    return;
+  }
+
+  if (second_size < TOOM3_THRESHOLD || 3 * second_size <= 2 * first_size) {
+    multiply_karatsuba(first, first_size, second, second_size, result);
+    return;
+  }
+
+  multiply_toom3(first, first_size, second, second_size, result);
+}
+
+void BigInteger::square_karatsuba(const limb* value, size_t size, limb* result) {
+  size_t half = size / 2;
+  size_t high = size - half;
+
+  LimbVector sum(value, value + half);
+  sum.resize(high + 1, 0);
+  add_limbs(sum.data(), sum.size(), value + half, high);
+
+  LimbVector middle(2 * sum.size());
+  run_tasks(run_parallel(size),
+      [&] { square_limbs(sum.data(), sum.size(), middle.data()); },
+      [&] { square_limbs(value, half, result); },
+      [&] { square_limbs(value + half, high, result + 2 * half); });
+  subtract_limbs(middle.data(), middle.size(), result, 2 * half);
+  subtract_limbs(middle.data(), middle.size(), result + 2 * half, 2 * high);
+
+  size_t middle_size = middle.size();
+  while (middle_size > 0 && middle[middle_size - 1] == 0) {
+    --middle_size;
+  }
+  add_limbs(result + half, 2 * size - half, middle.data(), middle_size);
+}
+
+void BigInteger::square_toom3(const limb* value, size_t size, limb* result) {
+  size_t part = (size + 2) / 3;
+
+  BigInteger number;
+  number.digits_.assign(value, value + size);
+  BigInteger a0 = limbs_slice(number, part * 0, part * 1);
+  BigInteger a1 = limbs_slice(number, part * 1, part * 2);
+  BigInteger a2 = limbs_slice(number, part * 2, part * 3);
+
+  BigInteger a_even = a0 + a2;
+  BigInteger a_minus_one = a_even - a1;
+  BigInteger a_minus_two = (a_minus_one + a2) * 2 - a0;
+
+  BigInteger a_one = a_even + a1;
+
+  BigInteger r0, r1, r_minus_one, r_minus_two, r4;
+  run_tasks(run_parallel(size),
+      [&] { r1 = square(a_one); },
+      [&] { r_minus_one = square(a_minus_one); },
+      [&] { r_minus_two = square(a_minus_two); },
+      [&] { r0 = square(a0); },
+      [&] { r4 = square(a2); });
+
+  interpolate_toom3(r0, r1, r_minus_one, r_minus_two, r4, part, result, 2 * size);
+}
+
+void BigInteger::square_limbs(const limb* value, size_t size, limb* result) {
+  if (size < KARATSUBA_THRESHOLD) {
+    square_schoolbook(value, size, result);
+    return;
+  }
+
+  if (size >= NTT_THRESHOLD && 2 * size <= NTT_MAX_SIZE) {
+    multiply_ntt(value, size, value, size, result);
+    return;
+  }
+
+  if (size < TOOM3_THRESHOLD) {
+    square_karatsuba(value, size, result);
+    return;
+  }
+
+  square_toom3(value, size, result);
+}
+
+// Montgomery arithmetic
+
+// -value^(-1) modulo BASE for odd value, by Newton's iteration (each step doubles the correct bits)
+BigInteger::limb BigInteger::montgomery_inverse(limb value) {
+  limb inverse = value;
+  for (int i = 0; i < 4; ++i) {
+    inverse *= 2 - value * inverse;
+  }
+  return -inverse;
+}
+
+// REDC: value holds a product below modulus * BASE^size in 2 * size + 1 limbs,
+// value * BASE^(-size) mod modulus is left in limbs [size, 2 * size)
+void BigInteger::montgomery_reduce(limb* value, const limb* modulus, size_t size, limb inverse) {
+  for (size_t i = 0; i < size; ++i) {
+    limb carry = mpn::addmul_1(value + i, modulus, size, value[i] * inverse);
+    mpn::add_1(value + i + size, value + i + size, size + 1 - i, carry);
+  }
+
+  if (value[2 * size] != 0 || compare_limbs(value + size, size, modulus, size) >= 0) {
+    subtract_limbs(value + size, size + 1, modulus, size);
+  }
+}
+
+// Division engine
+
+int BigInteger::compare_limbs(const limb* first, size_t first_size, const limb* second, size_t second_size) {
+  while (first_size > 0 && first[first_size - 1] == 0) {
+    --first_size;
+  }
+  while (second_size > 0 && second[second_size - 1] == 0) {
+    --second_size;
+  }
+  if (first_size != second_size) {
+    return first_size < second_size ? -1 : 1;
+  }
+  return mpn::cmp_n(first, second, first_size);
+}
+
+// Knuth's Algorithm D: quotient receives dividend_size - divider_size + 1 limbs, remainder divider_size limbs
+void BigInteger::divide_knuth(const limb* dividend, size_t dividend_size, const limb* divider, size_t divider_size, limb* quotient, limb* remainder) {
+  // Normalize so that the top bit of the divider is set
+  limb factor = limb(1) << std::countl_zero(divider[divider_size - 1]);
+  LimbVector current(dividend_size + 1);
+  LimbVector normalized(divider_size);
+  current[dividend_size] = mpn::mul_1(current.data(), dividend, dividend_size, factor);
+  mpn::mul_1(normalized.data(), divider, divider_size, factor);
+
+  divide_normalized(current.data(), current.size(), normalized.data(), divider_size, quotient);
+  mpn::divrem_1(remainder, current.data(), divider_size, factor);
+}
+
+// Core of Algorithm D for a normalized divider: quotient receives current_size - divider_size limbs,
+// the remainder is left in the low divider_size limbs of current
+void BigInteger::divide_normalized(limb* current, size_t current_size, const limb* normalized, size_t divider_size, limb* quotient) {
+  double_limb top = normalized[divider_size - 1];
+  double_limb second = normalized[divider_size - 2];
+
+  for (size_t j = current_size - divider_size; j > 0; --j) {
+    limb* window = current + j - 1;
+
+    double_limb number = (static_cast<double_limb>(window[divider_size]) << LIMB_BITS) | window[divider_size - 1];
+    double_limb estimate = number / top;
+    double_limb rest = number % top;
+    while (estimate >= BASE || estimate * second > ((rest << LIMB_BITS) | window[divider_size - 2])) {
+      --estimate;
+      rest += top;
+      if (rest >= BASE) {
+        break;
+      }
+    }
+
+    // Multiply and subtract, the estimate is at most one too large here
+    long long diff = static_cast<long long>(window[divider_size]) - mpn::submul_1(window, normalized, divider_size, estimate);
+    if (diff < 0) {
+      --estimate;
+      diff += mpn::add_n(window, window, normalized, divider_size);
+    }
+    window[divider_size] = diff;
+    quotient[j - 1] = estimate;
+  }
+}
+
+void BigInteger::divide_quadratic(const BigInteger& dividend, const BigInteger& divider, BigInteger& quotient, BigInteger& remainder) {
+  size_t dividend_size = dividend.digits_.size();
+  size_t divider_size = divider.digits_.size();
+  if (dividend.sign_ == sign::ZERO || compare_limbs(dividend.digits_.data(), dividend_size, divider.digits_.data(), divider_size) < 0) {
+    LimbVector limbs = dividend.digits_;
+    remainder.set_magnitude(limbs, sign::POSITIVE);
+    quotient = 0;
+    return;
+  }
+
+  LimbVector quotient_limbs(dividend_size - divider_size + 1);
+  LimbVector remainder_limbs(divider_size);
+  if (divider_size == 1) {
+    remainder_limbs[0] = mpn::divrem_1(quotient_limbs.data(), dividend.digits_.data(), dividend_size, divider.digits_[0]);
+  } else {
+    divide_knuth(dividend.digits_.data(), dividend_size, divider.digits_.data(), divider_size, quotient_limbs.data(), remainder_limbs.data());
+  }
+  quotient.set_magnitude(quotient_limbs, sign::POSITIVE);
+  remainder.set_magnitude(remainder_limbs, sign::POSITIVE);
+}
+
+// Burnikel-Ziegler: divides dividend < BASE^size * divider by a normalized divider of exactly size limbs
+void BigInteger::divide_two_by_one(const BigInteger& dividend, const BigInteger& divider, size_t size, BigInteger& quotient, BigInteger& remainder) {
+  if (size < BURNIKEL_ZIEGLER_THRESHOLD) {
+    divide_quadratic(dividend, divider, quotient, remainder);
+    return;
+  }
+
+  if (size % 2 != 0) {
+    divide_two_by_one(shift_limbs(dividend, 1), shift_limbs(divider, 1), size + 1, quotient, remainder);
+    remainder = limbs_slice(remainder, 1, remainder.digits_.size());
+    return;
+  }
+
+  size_t half = size / 2;
+  BigInteger divider_high = limbs_slice(divider, half, size);
+  BigInteger divider_low = limbs_slice(divider, 0, half);
+
+  BigInteger quotient_high;
+  BigInteger rest;
+  divide_three_by_two(limbs_slice(dividend, size, dividend.digits_.size()), limbs_slice(dividend, half, size), divider, divider_high, divider_low, half, quotient_high, rest);
+  BigInteger quotient_low;
+  divide_three_by_two(rest, limbs_slice(dividend, 0, half), divider, divider_high, divider_low, half, quotient_low, remainder);
+
+  quotient = shift_limbs(quotient_high, half);
+  quotient += quotient_low;
+}
+
+void BigInteger::divide_three_by_two(const BigInteger& high, const BigInteger& low, const BigInteger& divider, const BigInteger& divider_high, const BigInteger& divider_low, size_t size, BigInteger& quotient, BigInteger& remainder) {
+  if (limbs_slice(high, size, high.digits_.size()) == divider_high) {
+    quotient = shift_limbs(1, size) - 1;
+    remainder = high - shift_limbs(divider_high, size) + divider_high;
+  } else {
+    divide_two_by_one(high, divider_high, size, quotient, remainder);
+  }
+
+  remainder = shift_limbs(remainder, size) + low - quotient * divider_low;
+  while (remainder.sign_ == sign::NEGATIVE) {
+    --quotient;
+    remainder += divider;
+  }
+}
+
+void BigInteger::divide_recursive(const BigInteger& dividend, const BigInteger& divider, BigInteger& quotient, BigInteger& remainder) {
+  size_t size = divider.digits_.size();
+  limb factor = limb(1) << std::countl_zero(divider.digits_.back());
+
+  LimbVector limbs(size);
+  mpn::mul_1(limbs.data(), divider.digits_.data(), size, factor);
+  BigInteger normalized_divider;
+  normalized_divider.set_magnitude(limbs, sign::POSITIVE);
+
+  limbs.assign(dividend.digits_.size() + 1, 0);
+  limbs.back() = mpn::mul_1(limbs.data(), dividend.digits_.data(), dividend.digits_.size(), factor);
+  BigInteger normalized_dividend;
+  normalized_dividend.set_magnitude(limbs, sign::POSITIVE);
+
+  // Schoolbook division in base BASE^size, every step is a 2n-by-n recursive division
+  size_t blocks = (normalized_dividend.digits_.size() + size - 1) / size;
+  LimbVector quotient_limbs(blocks * size, 0);
+  BigInteger rest = 0;
+  BigInteger digit;
+  for (size_t i = blocks; i > 0; --i) {
+    BigInteger part = shift_limbs(rest, size);
+    part += limbs_slice(normalized_dividend, (i - 1) * size, i * size);
+    divide_two_by_one(part, normalized_divider, size, digit, rest);
+    if (digit.sign_ != sign::ZERO) {
+      std::copy(std::as_const(digit.digits_).begin(), std::as_const(digit.digits_).end(), quotient_limbs.begin() + (i - 1) * size);
+    }
+  }
+
+  quotient.set_magnitude(quotient_limbs, sign::POSITIVE);
+  rest.divide_by_limb(factor);
+  remainder = rest;
+}
+
+void BigInteger::divide(const BigInteger& dividend, const BigInteger& divider, BigInteger* quotient, BigInteger* remainder) {
+  sign dividend_sign = dividend.sign_;
+  int quotient_sign = static_cast<int>(dividend.sign_) * static_cast<int>(divider.sign_);
+
+  BigInteger quotient_value;
+  BigInteger remainder_value;
+  size_t divider_size = divider.digits_.size();
+  if (divider_size >= BURNIKEL_ZIEGLER_THRESHOLD && dividend.digits_.size() >= divider_size + BURNIKEL_ZIEGLER_THRESHOLD) {
+    divide_recursive(dividend, divider, quotient_value, remainder_value);
+  } else {
+    divide_quadratic(dividend, divider, quotient_value, remainder_value);
+  }
+
+  if (quotient != nullptr) {
+    quotient->set_magnitude(quotient_value.digits_, quotient_sign == 1 ? sign::POSITIVE : sign::NEGATIVE);
+  }
+  if (remainder != nullptr) {
+    remainder->set_magnitude(remainder_value.digits_, dividend_sign);
+  }
+}
+
+// GCD engine
+
+// Unimodular transform of a GCD reduction: the reduced pair is (m00 * a + m01 * b, m10 * a + m11 * b)
+struct BigInteger::GcdMatrix {
+  BigInteger m00, m01, m10, m11;
+};
+
+// Stein's binary GCD
+BigInteger::double_limb BigInteger::gcd_binary(double_limb first, double_limb second) {
+  if (first == 0 || second == 0) {
+    return first | second;
+  }
+
+  int shift = std::countr_zero(first | second);
+  first >>= std::countr_zero(first);
+  while (second != 0) {
+    second >>= std::countr_zero(second);
+    if (first > second) {
+      std::swap(first, second);
+    }
+    second -= first;
+  }
+  return first << shift;
+}
+
+// Lehmer: Euclid's algorithm on the leading 64 bits of a >= b, as long as Jebelean's condition
+// guarantees the quotients are also those of a and b. cofactors receives the magnitudes
+// (s0, t0, s1, t1) of the reduced pair |s0 * a - t0 * b|, |s1 * a - t1 * b|, all below BASE.
+bool BigInteger::lehmer_cofactors(const BigInteger& a, const BigInteger& b, limb* cofactors) {
+  size_t size = a.digits_.size();
+  int shift = std::countl_zero(a.digits_.back());
+  auto leading = [&](const BigInteger& value) {
+    auto at = [&](size_t index) -> double_limb { return index < value.digits_.size() ? value.digits_[index] : 0; };
+    double_limb high = (at(size - 1) << LIMB_BITS) | at(size - 2);
+    return (shift == 0) ? high : (high << shift) | (at(size - 3) >> (LIMB_BITS - shift));
+  };
+
+  double_limb r0 = leading(a);
+  double_limb r1 = leading(b);
+  double_limb s0 = 1;
+  double_limb t0 = 0;
+  double_limb s1 = 0;
+  double_limb t1 = 1;
+  bool progress = false;
+  while (r1 != 0) {
+    double_limb quotient = r0 / r1;
+    if (quotient >= BASE) {
+      break;
+    }
+    double_limb r2 = r0 - quotient * r1;
+    double_limb s2 = s0 + quotient * s1;
+    double_limb t2 = t0 + quotient * t1;
+    if (t2 >= BASE || r2 < t2 || r1 - r2 < t1 + t2) {
+      break;
+    }
+    r0 = r1;
+    r1 = r2;
+    s0 = s1;
+    t0 = t1;
+    s1 = s2;
+    t1 = t2;
+    progress = true;
+  }
+
+  cofactors[0] = s0;
+  cofactors[1] = t0;
+  cofactors[2] = s1;
+  cofactors[3] = t1;
+  return progress;
+}
+
+// result = |first_factor * first - second_factor * second|, returns whether the difference is negative
+bool BigInteger::combine_limbs(const BigInteger& first, limb first_factor, const BigInteger& second, limb second_factor, BigInteger& result) {
+  size_t size = std::max(first.digits_.size(), second.digits_.size()) + 1;
+  LimbVector limbs(size);
+  auto difference = [&](const BigInteger& minuend, limb minuend_factor, const BigInteger& subtrahend, limb subtrahend_factor) {
+    std::fill(limbs.begin(), limbs.end(), 0);
+    limbs[minuend.digits_.size()] = mpn::mul_1(limbs.data(), minuend.digits_.data(), minuend.digits_.size(), minuend_factor);
+    size_t subtrahend_size = subtrahend.digits_.size();
+    limb borrow = mpn::submul_1(limbs.data(), subtrahend.digits_.data(), subtrahend_size, subtrahend_factor);
+    return mpn::sub_1(limbs.data() + subtrahend_size, limbs.data() + subtrahend_size, size - subtrahend_size, borrow) != 0;
+  };
+
+  bool negative = difference(first, first_factor, second, second_factor);
+  if (negative) {
+    difference(second, second_factor, first, first_factor);
+  }
+  result.set_magnitude(limbs, sign::POSITIVE);
+  return negative;
+}
+
+// (a, b) <- matrix * (a, b), given the already transformed (a_high, b_high) = matrix * (a, b) / BASE^shift
+// of the top limbs. The rows of matrix are negated or swapped to keep a >= b >= 0.
+void BigInteger::apply_gcd_matrix(GcdMatrix& matrix, BigInteger& a, BigInteger& b, size_t shift, const BigInteger& a_high, const BigInteger& b_high) {
+  BigInteger a_low = limbs_slice(a, 0, shift);
+  BigInteger b_low = limbs_slice(b, 0, shift);
+  BigInteger new_a = shift_limbs(a_high, shift);
+  new_a.addmul(matrix.m00, a_low);
+  new_a.addmul(matrix.m01, b_low);
+  BigInteger new_b = shift_limbs(b_high, shift);
+  new_b.addmul(matrix.m10, a_low);
+  new_b.addmul(matrix.m11, b_low);
+  if (new_a.sign_ == sign::NEGATIVE) {
+    new_a = -std::move(new_a);
+    matrix.m00 = -std::move(matrix.m00);
+    matrix.m01 = -std::move(matrix.m01);
+  }
+  if (new_b.sign_ == sign::NEGATIVE) {
+    new_b = -std::move(new_b);
+    matrix.m10 = -std::move(matrix.m10);
+    matrix.m11 = -std::move(matrix.m11);
+  }
+  if (new_a < new_b) {
+    std::swap(new_a, new_b);
+    std::swap(matrix.m00, matrix.m10);
+    std::swap(matrix.m01, matrix.m11);
+  }
+  a = std::move(new_a);
+  b = std::move(new_b);
+}
+
+// second <- first * second
+void BigInteger::multiply_gcd_matrices(const GcdMatrix& first, GcdMatrix& second) {
+  GcdMatrix product{first.m00 * second.m00, first.m00 * second.m01, first.m10 * second.m00, first.m10 * second.m01};
+  product.m00.addmul(first.m01, second.m10);
+  product.m01.addmul(first.m01, second.m11);
+  product.m10.addmul(first.m11, second.m10);
+  product.m11.addmul(first.m11, second.m11);
+  second = std::move(product);
+}
+
+// One Lehmer step, or a division step when the leading limbs do not determine a quotient
+void BigInteger::gcd_step(BigInteger& a, BigInteger& b, GcdMatrix* matrix) {
+  limb cofactors[4];
+  if (lehmer_cofactors(a, b, cofactors)) {
+    BigInteger new_a;
+    BigInteger new_b;
+    bool negative_a = combine_limbs(a, cofactors[0], b, cofactors[1], new_a);
+    bool negative_b = combine_limbs(a, cofactors[2], b, cofactors[3], new_b);
+    a = std::move(new_a);
+    b = std::move(new_b);
+
+    if (matrix != nullptr) {
+      GcdMatrix step{cofactors[0], -static_cast<long long>(cofactors[1]), cofactors[2], -static_cast<long long>(cofactors[3])};
+      if (negative_a) {
+        step.m00 = -std::move(step.m00);
+        step.m01 = -std::move(step.m01);
+      }
+      if (negative_b) {
+        step.m10 = -std::move(step.m10);
+        step.m11 = -std::move(step.m11);
+      }
+      multiply_gcd_matrices(step, *matrix);
+    }
+  } else {
+    auto [quotient, remainder] = divmod(a, b);
+    a = std::move(b);
+    b = std::move(remainder);
+
+    if (matrix != nullptr) {
+      std::swap(matrix->m00, matrix->m10);
+      std::swap(matrix->m01, matrix->m11);
+      matrix->m10.submul(quotient, matrix->m00);
+      matrix->m11.submul(quotient, matrix->m01);
+    }
+  }
+
+  if (a < b) {
+    std::swap(a, b);
+    if (matrix != nullptr) {
+      std::swap(matrix->m00, matrix->m10);
+      std::swap(matrix->m01, matrix->m11);
+    }
+  }
+}
+
+// Reduces a >= b > 0 of n limbs to about n / 2 limbs. The top halves are reduced recursively twice
+// and their transforms applied to the full values, so the cost is O(M(n) log n). Any unimodular
+// transform preserves the GCD, a quotient guessed wrong from the truncated values only costs speed.
+void BigInteger::half_gcd(BigInteger& a, BigInteger& b, GcdMatrix& matrix) {
+  size_t size = a.digits_.size();
+  size_t target = size / 2 + 1;
+  matrix = GcdMatrix{1, 0, 0, 1};
+
+  if (size >= HALF_GCD_THRESHOLD) {
+    BigInteger a_high = limbs_slice(a, size / 2, size);
+    BigInteger b_high = limbs_slice(b, size / 2, size);
+    if (b_high.sign_ != sign::ZERO) {
+      half_gcd(a_high, b_high, matrix);
+      apply_gcd_matrix(matrix, a, b, size / 2, a_high, b_high);
+    }
+
+    if (a.digits_.size() > target && b.sign_ != sign::ZERO) {
+      gcd_step(a, b, &matrix);
+    }
+
+    size_t current_size = a.digits_.size();
+    if (current_size > target + 1 && current_size < 2 * target && b.sign_ != sign::ZERO) {
+      // The top 2 * (current_size - target) limbs reduce to about current_size - target limbs
+      size_t shift = 2 * target - current_size;
+      a_high = limbs_slice(a, shift, current_size);
+      b_high = limbs_slice(b, shift, current_size);
+      if (b_high.sign_ != sign::ZERO) {
+        GcdMatrix second;
+        half_gcd(a_high, b_high, second);
+        apply_gcd_matrix(second, a, b, shift, a_high, b_high);
+        multiply_gcd_matrices(second, matrix);
+      }
+    }
+  }
+
+  while (a.digits_.size() > target && b.sign_ != sign::ZERO) {
+    gcd_step(a, b, &matrix);
+  }
+}
+
+// Reduces a >= b >= 0 until b == 0, a is left with the GCD. matrix (if any) accumulates the transform.
+void BigInteger::gcd_reduce(BigInteger& a, BigInteger& b, GcdMatrix* matrix) {
+  while (b.sign_ != sign::ZERO) {
+    size_t size = a.digits_.size();
+    if (matrix == nullptr && size <= 2) {
+      auto value = [](const BigInteger& number) {
+        return number.digits_[0] | (number.digits_.size() > 1 ? static_cast<double_limb>(number.digits_[1]) << LIMB_BITS : 0);
+      };
+      double_limb result = gcd_binary(value(a), value(b));
+      a.digits_.assign(1, static_cast<limb>(result));
+      if (result >> LIMB_BITS != 0) {
+        a.digits_.push_back(result >> LIMB_BITS);
+      }
+      b = 0;
+    } else if (size >= HALF_GCD_THRESHOLD && b.digits_.size() + 1 >= size) {
+      GcdMatrix step;
+      half_gcd(a, b, step);
+      if (matrix != nullptr) {
+        multiply_gcd_matrices(step, *matrix);
+      }
+    } else {
+      gcd_step(a, b, matrix);
+    }
+  }
+}
+
+BigInteger gcd(const BigInteger& first, const BigInteger& second) {
+  return BigInteger::with_scratch([&] {
+    BigInteger a = abs(first);
+    BigInteger b = abs(second);
+    if (a < b) {
+      std::swap(a, b);
+    }
+    BigInteger::gcd_reduce(a, b, nullptr);
+    return a;
+  });
+}
+
+BigInteger lcm(const BigInteger& first, const BigInteger& second) {
+  if (!first || !second) {
+    return 0;
+  }
+  return abs(first / gcd(first, second) * second);
+}
+
+BigInteger gcdext(const BigInteger& first, const BigInteger& second, BigInteger& x, BigInteger& y) {
+  BigInteger a = abs(first);
+  BigInteger b = abs(second);
+  bool swapped = a < b;
+  if (swapped) {
+    std::swap(a, b);
+  }
+  BigInteger::GcdMatrix matrix{1, 0, 0, 1};
+  BigInteger::gcd_reduce(a, b, &matrix);
+
+  BigInteger first_factor = swapped ? matrix.m01 : matrix.m00;
+  BigInteger second_factor = swapped ? matrix.m00 : matrix.m01;
+  if (first.sign_ == BigInteger::sign::NEGATIVE) {
+    first_factor = -std::move(first_factor);
+  }
+  if (second.sign_ == BigInteger::sign::NEGATIVE) {
+    second_factor = -std::move(second_factor);
+  }
+
+  if (a.sign_ == BigInteger::sign::ZERO) {
+    first_factor = 0;
+    second_factor = 0;
+  } else if (first.sign_ != BigInteger::sign::ZERO && second.sign_ != BigInteger::sign::ZERO) {
+    // Smallest solution: first_factor is reduced modulo |second| / gcd
+    BigInteger period = abs(second) / a;
+    first_factor %= period;
+    if (abs(first_factor) * 2 > period) {
+      first_factor += (first_factor.sign_ == BigInteger::sign::POSITIVE) ? -period : period;
+    }
+    second_factor = (a - first * first_factor) / second;
+  }
+
+  x = std::move(first_factor);
+  y = std::move(second_factor);
+  return a;
+}
+
+// Constructors
+
+BigInteger::BigInteger(long long num) {
+  sign_ = num > 0 ? (sign::POSITIVE) : (num == 0 ? sign::ZERO : sign::NEGATIVE);
+  unsigned long long magnitude = (num < 0) ? 0ULL - static_cast<unsigned long long>(num) : num;
+
+  if (magnitude == 0) {
+    digits_.push_back(0);
+  } else {
+    while (magnitude > 0) {
+      digits_.push_back(magnitude % BASE);
+      magnitude /= BASE;
+    }
+  }
+}
+
+BigInteger::BigInteger(const std::string& str): digits_(1, 0), sign_(sign::ZERO) {
+  std::from_chars_result result = from_chars(str.data(), str.data() + str.size(), *this);
+  if (result.ec != std::errc() || result.ptr != str.data() + str.size()) {
+    throw std::invalid_argument("BigInteger: not a decimal number: \"" + str + "\"");
+  }
+}
+
+// Comparison operators
+
+bool operator==(const BigInteger& first, const BigInteger& second) {
+  if (first.sign_ != second.sign_) {
+    return false;
+  }
+
+  if (first.sign_ == BigInteger::sign::ZERO) {
+    return true;
+  }
+
+  return first.digits_ == second.digits_;
+}
+
+bool operator<(const BigInteger& first, const BigInteger& second) {
+  return (first <=> second) < 0;
+}
+
+bool operator!=(const BigInteger& first, const BigInteger& second) {
+  return !(first == second);
+}
+
+bool operator>=(const BigInteger& first, const BigInteger& second) {
+  return !(first < second);
+}
+
+bool operator>(const BigInteger& first, const BigInteger& second) {
+  return second < first;
+}
+
+bool operator<=(const BigInteger& first, const BigInteger& second) {
+  return !(second < first);
+}
+
+std::strong_ordering operator<=>(const BigInteger& first, const BigInteger& second) {
+  if (first.sign_ != second.sign_) {
+    return first.sign_ <=> second.sign_;
+  }
+
+  if (first.sign_ == BigInteger::sign::ZERO) {
+    return std::strong_ordering::equal;
+  }
+
+  int comparison = BigInteger::compare_limbs(first.digits_.data(), first.digits_.size(), second.digits_.data(), second.digits_.size());
+  return (first.sign_ == BigInteger::sign::NEGATIVE) ? 0 <=> comparison : comparison <=> 0;
+}
+
+// Calculation binary operators
+
+BigInteger& BigInteger::operator+=(const BigInteger& other) {
+  if (other.sign_ == sign::ZERO) {
+    return *this;
+  }
+
+  if (sign_ == sign::ZERO) {
+    *this = other;
+  } else if (sign_ == other.sign_) {
+    add_magnitude(other);
+  } else {
+    subtract_magnitude(other);
+  }
+  return *this;
+}
+
+BigInteger& BigInteger::operator-=(const BigInteger& other) {
+  if (other.sign_ == sign::ZERO) {
+    return *this;
+  }
+
+  if (sign_ == sign::ZERO) {
+    *this = -other;
+  } else if (sign_ != other.sign_) {
+    add_magnitude(other);
+  } else {
+    subtract_magnitude(other);
+  }
+  return *this;
+}
+
+BigInteger& BigInteger::operator*=(const BigInteger& other) {
+  if (sign_ == sign::ZERO || other.sign_ == sign::ZERO) {
+    *this = 0;
+    return *this;
+  }
+
+  int sign = static_cast<int>(sign_) * static_cast<int>(other.sign_);
+  LimbVector result(digits_.size() + other.digits_.size());
+  const limb* limbs = std::as_const(digits_).data();
+  if (&other == this) {
+    square_limbs(limbs, digits_.size(), result.data());
+  } else {
+    multiply_limbs(limbs, digits_.size(), other.digits_.data(), other.digits_.size(), result.data());
+  }
+  digits_.swap(result);
+  remove_leading_zeroes();
+  sign_ = (sign == 1) ? sign::POSITIVE : sign::NEGATIVE;
+  return *this;
+}
+
+// The product goes through a thread-local scratch value, so accumulation loops stop allocating
+// once its capacity has grown
+BigInteger& BigInteger::add_product(const BigInteger& first, const BigInteger& second, int product_sign) {
+  if (product_sign == 0) {
+    return *this;
+  }
+
+  thread_local BigInteger product;
+  limb* product_limbs;
+  {
+    // The scratch value outlives any scope, so it stays on the heap. That includes the block taken
+    // when it has to unshare from a value the last sum was assigned to.
+    MemoryScope heap(nullptr);
+    product.digits_.resize(first.digits_.size() + second.digits_.size());
+    product_limbs = product.digits_.data();
+  }
+  if (&first == &second) {
+    square_limbs(first.digits_.data(), first.digits_.size(), product_limbs);
+  } else {
+    multiply_limbs(first.digits_.data(), first.digits_.size(), second.digits_.data(), second.digits_.size(), product_limbs);
+  }
+  product.remove_leading_zeroes();
+  product.sign_ = (product_sign > 0) ? sign::POSITIVE : sign::NEGATIVE;
+  return *this += product;
+}
+
+BigInteger& BigInteger::addmul(const BigInteger& first, const BigInteger& second) {
+  return add_product(first, second, static_cast<int>(first.sign_) * static_cast<int>(second.sign_));
+}
+
+BigInteger& BigInteger::submul(const BigInteger& first, const BigInteger& second) {
+  return add_product(first, second, -static_cast<int>(first.sign_) * static_cast<int>(second.sign_));
+}
+
+BigInteger& BigInteger::operator/=(const BigInteger& other) {
+  divide(*this, other, this, nullptr);
+  return *this;
+}
+
+BigInteger& BigInteger::operator%=(const BigInteger& other) {
+  divide(*this, other, nullptr, this);
+  return *this;
+}
+
+BigInteger operator+(const BigInteger& first, const BigInteger& second) {
+  BigInteger result = first;
+  result += second;
+  return result;
+}
+
+BigInteger operator-(const BigInteger& first, const BigInteger& second) {
+  BigInteger result = first;
+  result -= second;
+  return result;
+}
+
+BigInteger operator*(const BigInteger& first, const BigInteger& second) {
+  BigInteger result = first;
+  result *= second;
+  return result;
+}
+
+BigInteger operator/(const BigInteger& first, const BigInteger& second) {
+  BigInteger result = first;
+  result /= second;
+  return result;
+}
+
+BigInteger operator%(const BigInteger& first, const BigInteger& second) {
+  BigInteger result = first;
+  result %= second;
+  return result;
+}
+
+BigInteger operator+(BigInteger&& first, const BigInteger& second) {
+  first += second;
+  return std::move(first);
+}
+
+BigInteger operator+(const BigInteger& first, BigInteger&& second) {
+  second += first;
+  return std::move(second);
+}
+
+BigInteger operator+(BigInteger&& first, BigInteger&& second) {
+  first += second;
+  return std::move(first);
+}
+
+BigInteger operator-(BigInteger&& first, const BigInteger& second) {
+  first -= second;
+  return std::move(first);
+}
+
+BigInteger operator*(BigInteger&& first, const BigInteger& second) {
+  first *= second;
+  return std::move(first);
+}
+
+BigInteger operator*(const BigInteger& first, BigInteger&& second) {
+  second *= first;
+  return std::move(second);
+}
+
+BigInteger operator*(BigInteger&& first, BigInteger&& second) {
+  first *= second;
+  return std::move(first);
+}
+
+BigInteger operator/(BigInteger&& first, const BigInteger& second) {
+  first /= second;
+  return std::move(first);
+}
+
+BigInteger operator%(BigInteger&& first, const BigInteger& second) {
+  first %= second;
+  return std::move(first);
+}
+
+std::pair<BigInteger, BigInteger> divmod(const BigInteger& dividend, const BigInteger& divider) {
+  std::pair<BigInteger, BigInteger> result;
+  BigInteger::divide(dividend, divider, &result.first, &result.second);
+  return result;
+}
+
+// Calculation unary operators
+
+BigInteger BigInteger::operator-() const& {
+  BigInteger result = *this;
+  return -std::move(result);
+}
+
+BigInteger BigInteger::operator-() && {
+  sign_ = (sign_ == sign::ZERO) ? sign::ZERO : (sign_ == sign::NEGATIVE ? sign::POSITIVE : sign::NEGATIVE);
+  return std::move(*this);
+}
+
+BigInteger& BigInteger::operator++() { return (*this += 1); }
+
+BigInteger BigInteger::operator++(int) {
+  BigInteger copy(*this);
+  *this += 1;
+  return copy;
+}
+
+BigInteger& BigInteger::operator--() { return (*this -= 1); }
+
+BigInteger BigInteger::operator--(int) {
+  BigInteger copy(*this);
+  *this -= 1;
+  return copy;
+}
+
+// Floating point conversion
+
+template <std::floating_point Float>
+BigInteger::BigInteger(Float number): digits_(2, 0), sign_(sign::ZERO) {
+  // |number| = bits * 2^exponent with a 64-bit integer bits
+  int exponent;
+  unsigned long long bits = static_cast<unsigned long long>(std::ldexp(std::frexp(std::fabs(number), &exponent), 64));
+  exponent -= 64;
+  if (exponent < 0) {
+    bits = (exponent > -64) ? bits >> -exponent : 0;
+    exponent = 0;
+  }
+
+  digits_[0] = static_cast<limb>(bits);
+  digits_[1] = static_cast<limb>(bits >> LIMB_BITS);
+  remove_leading_zeroes();
+  if (bits != 0) {
+    sign_ = (number < 0) ? sign::NEGATIVE : sign::POSITIVE;
+    if (exponent > 0) {
+      *this = shift_bits(*this, exponent);
+    }
+  }
+}
+
+// Magnitude rounded to a multiple of 2^position, to nearest with ties to even (sticky stands for
+// nonzero bits below the whole magnitude). The bits from position up must fit into the mantissa.
+template <class Float>
+Float BigInteger::round_to_floating(size_t position, bool sticky) const {
+  auto bit = [this](size_t index) {
+    return index / LIMB_BITS < digits_.size() && ((digits_[index / LIMB_BITS] >> (index % LIMB_BITS)) & 1) != 0;
+  };
+
+  size_t low = position / LIMB_BITS;
+  Float mantissa = 0;
+  for (size_t i = digits_.size(); i-- > low;) {
+    limb value = (i == low) ? digits_[i] & (~limb(0) << (position % LIMB_BITS)) : digits_[i];
+    mantissa = mantissa * BASE + value;
+  }
+
+  if (position > 0 && bit(position - 1)) {
+    size_t below = position - 1;
+    if (below / LIMB_BITS < digits_.size()) {
+      sticky = sticky || (digits_[below / LIMB_BITS] & ((limb(1) << (below % LIMB_BITS)) - 1)) != 0;
+    }
+    for (size_t i = 0; !sticky && i < std::min(below / LIMB_BITS, digits_.size()); ++i) {
+      sticky = digits_[i] != 0;
+    }
+    if (sticky || bit(position)) {
+      mantissa += std::ldexp(Float(1), static_cast<int>(position % LIMB_BITS));
+    }
+  }
+  return std::ldexp(mantissa, static_cast<int>(low * LIMB_BITS));
+}
+
+template <class Float>
+Float BigInteger::to_floating() const {
+  const size_t digits = std::numeric_limits<Float>::digits;
+  size_t length = bit_length();
+  Float magnitude = round_to_floating<Float>((length > digits) ? length - digits : 0, false);
+  return (sign_ == sign::NEGATIVE) ? -magnitude : magnitude;
+}
+
+// Correctly rounded |numerator| / |denominator|. The quotient is scaled to carry two bits below the
+// last mantissa bit (or below the fixed subnormal step), the remainder only acts as a sticky bit.
+template <class Float>
+Float BigInteger::quotient_to_floating(const BigInteger& numerator, const BigInteger& denominator) {
+  const long long digits = std::numeric_limits<Float>::digits;
+  const long long min_exponent = std::numeric_limits<Float>::min_exponent;
+  if (numerator.sign_ == sign::ZERO) {
+    return 0;
+  }
+
+  // The quotient lies in (2^(exponent - 1), 2^(exponent + 1))
+  long long exponent = static_cast<long long>(numerator.bit_length()) - static_cast<long long>(denominator.bit_length());
+  if (exponent > std::numeric_limits<Float>::max_exponent + 1) {
+    return std::numeric_limits<Float>::infinity();
+  }
+  if (exponent < min_exponent - digits - 2) {
+    return 0;
+  }
+
+  long long scale = digits + 2 - std::max(exponent, min_exponent);
+  BigInteger dividend = abs(numerator), divider = abs(denominator);
+  if (scale > 0) {
+    dividend = shift_bits(dividend, scale);
+  } else if (scale < 0) {
+    divider = shift_bits(divider, -scale);
+  }
+  auto [quotient, remainder] = divmod(dividend, divider);
+
+  long long length = static_cast<long long>(quotient.bit_length());
+  long long position = std::max({length - digits, min_exponent - digits + scale, 0LL});
+  Float magnitude = quotient.round_to_floating<Float>(position, remainder.sign_ != sign::ZERO);
+  return std::ldexp(magnitude, static_cast<int>(-scale));
+}
+
+double BigInteger::toDouble() const { return to_floating<double>(); }
+
+long double BigInteger::toLongDouble() const { return to_floating<long double>(); }
+
+// Operator bool()
+
+BigInteger::operator bool() const {
+  if (sign_ == sign::ZERO) {
+    return false;
+  }
+  return true;
+}
+
+bool BigInteger::toLongLong(long long& result) const {
+  if (digits_.size() > 2) {
+    return false;
+  }
+
+  unsigned long long magnitude = 0;
+  for (size_t i = digits_.size(); i-- > 0;) {
+    magnitude = (magnitude << LIMB_BITS) | digits_[i];
+  }
+  if (magnitude > (~0ULL >> 1)) {
+    return false;
+  }
+
+  result = (sign_ == sign::NEGATIVE) ? -static_cast<long long>(magnitude) : static_cast<long long>(magnitude);
+  return true;
+}
+
+// toString()
+
+std::string BigInteger::toString() const{
+  std::string string(stringLengthBound(), '\0');
+  string.resize(to_chars(string.data(), string.data() + string.size(), *this).ptr - string.data());
+  return string;
+}
+
+// CLASS BIGDIVISOR
+
+// Divider prepared once for dividing many dividends. Short dividers keep their normalized limbs for
+// Algorithm D, long ones a Barrett reciprocal floor(BASE^(2 * size) / |divider|), the sizes in
+// between go through Burnikel-Ziegler division.
+class BigDivisor {
+ public:
+  explicit BigDivisor(const BigInteger& divider);
+
+  BigInteger div(const BigInteger& dividend) const;
+  BigInteger mod(const BigInteger& dividend) const;
+  std::pair<BigInteger, BigInteger> divmod(const BigInteger& dividend) const;
+
+  const BigInteger& divider() const;
+
+ private:
+  // Divider size (in limbs) from which Barrett reduction beats Algorithm D
+  static const size_t BARRETT_THRESHOLD = 1000;
+
+  BigInteger divider_;
+  BigInteger magnitude_;
+  LimbVector normalized_;
+  BigInteger::limb factor_;
+  BigInteger reciprocal_;
+
+  void divide(const BigInteger& dividend, BigInteger* quotient, BigInteger* remainder) const;
+  void reduce_barrett(const BigInteger& part, BigInteger& quotient, BigInteger& remainder) const;
+};
+
+// Constructor
+
+BigDivisor::BigDivisor(const BigInteger& divider): divider_(divider), magnitude_(abs(divider)), factor_(1) {
+  // magnitude_ may share its limbs with the divider, they are only read
+  const LimbVector& magnitude = magnitude_.digits_;
+  size_t size = magnitude.size();
+  if (size >= BARRETT_THRESHOLD) {
+    reciprocal_ = BigInteger::shift_limbs(1, 2 * size) / magnitude_;
+  } else if (size > 1 && size < BigInteger::BURNIKEL_ZIEGLER_THRESHOLD) {
+    factor_ = BigInteger::limb(1) << std::countl_zero(magnitude.back());
+    normalized_.resize(size);
+    mpn::mul_1(normalized_.data(), magnitude.data(), size, factor_);
+  }
+}
+
+// Division methods
+
+BigInteger BigDivisor::div(const BigInteger& dividend) const {
+  BigInteger quotient;
+  divide(dividend, &quotient, nullptr);
+  return quotient;
+}
+
+BigInteger BigDivisor::mod(const BigInteger& dividend) const {
+  BigInteger remainder;
+  divide(dividend, nullptr, &remainder);
+  return remainder;
+}
+
+std::pair<BigInteger, BigInteger> BigDivisor::divmod(const BigInteger& dividend) const {
+  std::pair<BigInteger, BigInteger> result;
+  divide(dividend, &result.first, &result.second);
+  return result;
+}
+
+const BigInteger& BigDivisor::divider() const { return divider_; }
+
+// Barrett step for part < BASE^size * |divider|, the estimate is at most two too small
+void BigDivisor::reduce_barrett(const BigInteger& part, BigInteger& quotient, BigInteger& remainder) const {
+  size_t size = magnitude_.digits_.size();
+  BigInteger estimate = BigInteger::limbs_slice(part, size - 1, part.digits_.size()) * reciprocal_;
+  quotient = BigInteger::limbs_slice(estimate, size + 1, estimate.digits_.size());
+  remainder = part - quotient * magnitude_;
+  while (remainder >= magnitude_) {
+    remainder -= magnitude_;
+    ++quotient;
+  }
+}
+
+void BigDivisor::divide(const BigInteger& dividend, BigInteger* quotient, BigInteger* remainder) const {
+  BigInteger::sign dividend_sign = dividend.sign_;
+  int quotient_sign = static_cast<int>(dividend.sign_) * static_cast<int>(divider_.sign_);
+
+  size_t size = magnitude_.digits_.size();
+  size_t dividend_size = dividend.digits_.size();
+  LimbVector quotient_limbs;
+  LimbVector remainder_limbs;
+
+  if (dividend.sign_ == BigInteger::sign::ZERO || BigInteger::compare_limbs(dividend.digits_.data(), dividend_size, magnitude_.digits_.data(), size) < 0) {
+    remainder_limbs = dividend.digits_;
+  } else if (size == 1) {
+    quotient_limbs.resize(dividend_size);
+    remainder_limbs.push_back(mpn::divrem_1(quotient_limbs.data(), dividend.digits_.data(), dividend_size, magnitude_.digits_[0]));
+  } else if (size < BigInteger::BURNIKEL_ZIEGLER_THRESHOLD) {
+    LimbVector current(dividend_size + 1);
+    current[dividend_size] = mpn::mul_1(current.data(), dividend.digits_.data(), dividend_size, factor_);
+    quotient_limbs.resize(dividend_size + 1 - size);
+    BigInteger::divide_normalized(current.data(), current.size(), normalized_.data(), size, quotient_limbs.data());
+    remainder_limbs.resize(size);
+    mpn::divrem_1(remainder_limbs.data(), current.data(), size, factor_);
+  } else if (size < BARRETT_THRESHOLD) {
+    BigInteger::divide(dividend, divider_, quotient, remainder);
+    return;
+  } else {
+    // Schoolbook division in base BASE^size with one Barrett step per block
+    size_t blocks = (dividend_size + size - 1) / size;
+    quotient_limbs.assign(blocks * size, 0);
+    BigInteger rest = 0;
+    BigInteger digit;
+    for (size_t i = blocks; i > 0; --i) {
+      BigInteger part = BigInteger::shift_limbs(rest, size);
+      part += BigInteger::limbs_slice(dividend, (i - 1) * size, i * size);
+      reduce_barrett(part, digit, rest);
+      if (digit.sign_ != BigInteger::sign::ZERO) {
+        std::copy(std::as_const(digit.digits_).begin(), std::as_const(digit.digits_).end(), quotient_limbs.begin() + (i - 1) * size);
+      }
+    }
+    remainder_limbs.swap(rest.digits_);
+  }
+
+  if (quotient != nullptr) {
+    quotient->set_magnitude(quotient_limbs, quotient_sign == 1 ? BigInteger::sign::POSITIVE : BigInteger::sign::NEGATIVE);
+  }
+  if (remainder != nullptr) {
+    remainder->set_magnitude(remainder_limbs, dividend_sign);
+  }
+}
+
+// Radix conversion
+
+// 10^(SIZE * 2^level), each level is the square of the previous one
+const BigInteger& BigInteger::decimal_power(size_t level) {
+  thread_local std::deque<BigInteger> powers;
+  MemoryScope heap(nullptr);
+  if (powers.empty()) {
+    powers.push_back(BigInteger(DECIMAL_BASE));
+  }
+  while (powers.size() <= level) {
+    powers.push_back(square(powers.back()));
+  }
+  return powers[level];
+}
+
+// Division by decimal_power(level) with its Barrett reciprocal, built on first use
+const BigDivisor& BigInteger::decimal_divisor(size_t level) {
+  thread_local std::deque<BigDivisor> divisors;
+  MemoryScope heap(nullptr);
+  while (divisors.size() <= level) {
+    divisors.emplace_back(decimal_power(divisors.size()));
+  }
+  return divisors[level];
+}
+
+// Exactly SIZE digits, zero-padded
+void BigInteger::write_decimal_chunk(limb chunk, char* out) {
+  for (int i = SIZE - 1; i >= 0; --i) {
+    out[i] = static_cast<char>('0' + chunk % 10);
+    chunk /= 10;
+  }
+}
+
+// Writes the magnitude of value, zero-padded to width digits (width == 0 means no padding),
+// and returns the end of the output
+char* BigInteger::write_decimal(const BigInteger& value, char* out, size_t width) {
+  size_t size = value.digits_.size();
+
+  if (size <= DECIMAL_CONVERSION_THRESHOLD) {
+    // Peel off chunks of SIZE digits, least significant first
+    limb rest[DECIMAL_CONVERSION_THRESHOLD];
+    limb chunks[DECIMAL_CONVERSION_THRESHOLD * 10 / SIZE + 1];
+    std::copy(value.digits_.begin(), value.digits_.end(), rest);
+    size_t count = 0;
+    while (size > 0 && rest[size - 1] == 0) {
+      --size;
+    }
+    while (size > 0) {
+      chunks[count++] = mpn::divrem_1(rest, rest, size, DECIMAL_BASE);
+      while (size > 0 && rest[size - 1] == 0) {
+        --size;
+      }
+    }
+
+    if (width == 0) {
+      if (count == 0) {
+        *out = '0';
+        return out + 1;
+      }
+      out = std::to_chars(out, out + SIZE, chunks[--count]).ptr;
+    } else {
+      out = std::fill_n(out, width - count * SIZE, '0');
+    }
+    for (size_t i = count; i > 0; --i, out += SIZE) {
+      write_decimal_chunk(chunks[i - 1], out);
+    }
+    return out;
+  }
+
+  // The largest cached power not longer than about half of the value
+  size_t level = 0;
+  while (2 * decimal_power(level + 1).digits_.size() - 1 <= size) {
+    ++level;
+  }
+  if (run_parallel(size)) {
+    std::vector<const BigDivisor*> divisors;
+    for (size_t i = 0; i <= level; ++i) {
+      divisors.push_back(&decimal_divisor(i));
+    }
+    return write_decimal_parallel(value, out, width, divisors);
+  }
+  size_t low_width = size_t(SIZE) << level;
+
+  auto [high, low] = decimal_divisor(level).divmod(value);
+  out = write_decimal(high, out, (width == 0) ? 0 : width - low_width);
+  return write_decimal(low, out, low_width);
+}
+
+// write_decimal with both halves of every split above the parallel threshold written concurrently. The
+// decimal_divisor() cache is per thread, so the levels come from the calling thread's one.
+char* BigInteger::write_decimal_parallel(const BigInteger& value, char* out, size_t width, const std::vector<const BigDivisor*>& divisors) {
+  size_t size = value.digits_.size();
+  if (size <= DECIMAL_CONVERSION_THRESHOLD || !run_parallel(size)) {
+    return write_decimal(value, out, width);
+  }
+
+  size_t level = divisors.size() - 1;
+  while (level > 0 && 2 * divisors[level]->divider().digits_.size() - 1 > size) {
+    --level;
+  }
+  size_t low_width = size_t(SIZE) << level;
+
+  auto [high, low] = divisors[level]->divmod(value);
+  if (width != 0) {
+    run_tasks(true,
+        [&] { write_decimal_parallel(high, out, width - low_width, divisors); },
+        [&] { write_decimal_parallel(low, out + width - low_width, low_width, divisors); });
+    return out + width;
+  }
+  // The length of the unpadded high part is not known in advance, the low part waits in a buffer
+  std::string buffer(low_width, '\0');
+  run_tasks(true,
+      [&] { out = write_decimal_parallel(high, out, 0, divisors); },
+      [&] { write_decimal_parallel(low, buffer.data(), low_width, divisors); });
+  return std::copy(buffer.begin(), buffer.end(), out);
+}
+
+// value = the decimal number written in [first, first + length)
+void BigInteger::read_decimal(const char* first, size_t length, BigInteger& value) {
+  if (length <= DECIMAL_CONVERSION_THRESHOLD * SIZE) {
+    // Horner's scheme over chunks of SIZE digits
+    value.digits_.assign(1, 0);
+    size_t chunk_length = length % SIZE;
+    if (chunk_length == 0) {
+      chunk_length = SIZE;
+    }
+    for (const char* last = first + length; first != last; first += chunk_length, chunk_length = SIZE) {
+      limb chunk = 0;
+      limb multiplier = 1;
+      for (size_t i = 0; i < chunk_length; ++i) {
+        chunk = chunk * 10 + (first[i] - '0');
+        multiplier *= 10;
+      }
+      value.multiply_add(multiplier, chunk);
+    }
+    value.sign_ = (value.digits_.size() == 1 && value.digits_[0] == 0) ? sign::ZERO : sign::POSITIVE;
+    return;
+  }
+
+  // The low part takes the largest power of ten that leaves a nonempty high part
+  size_t level = 0;
+  while ((size_t(SIZE) << (level + 1)) < length) {
+    ++level;
+  }
+  if (run_parallel(length / SIZE)) {
+    std::vector<const BigInteger*> powers;
+    for (size_t i = 0; i <= level; ++i) {
+      powers.push_back(&decimal_power(i));
+    }
+    read_decimal_parallel(first, length, value, powers);
+    return;
+  }
+  size_t low_length = size_t(SIZE) << level;
+
+  BigInteger low;
+  read_decimal(first, length - low_length, value);
+  read_decimal(first + length - low_length, low_length, low);
+  value *= decimal_power(level);
+  value += low;
+}
+
+// read_decimal with both parts of every split above the parallel threshold read concurrently, powers
+// are the calling thread's decimal_power() levels
+void BigInteger::read_decimal_parallel(const char* first, size_t length, BigInteger& value, const std::vector<const BigInteger*>& powers) {
+  if (length <= DECIMAL_CONVERSION_THRESHOLD * SIZE || !run_parallel(length / SIZE)) {
+    read_decimal(first, length, value);
+    return;
+  }
+
+  size_t level = 0;
+  while ((size_t(SIZE) << (level + 1)) < length) {
+    ++level;
+  }
+  size_t low_length = size_t(SIZE) << level;
+
+  BigInteger low;
+  run_tasks(true,
+      [&] { read_decimal_parallel(first, length - low_length, value, powers); },
+      [&] { read_decimal_parallel(first + length - low_length, low_length, low, powers); });
+  value *= *powers[level];
+  value += low;
+}
+
+size_t BigInteger::stringLengthBound() const {
+  // A limb holds less than 10 decimal digits, one more character for the sign
+  return std::max<size_t>(digits_.size(), 1) * 10 + 1;
+}
+
+std::to_chars_result to_chars(char* first, char* last, const BigInteger& value) {
+  size_t bound = value.stringLengthBound();
+  if (static_cast<size_t>(last - first) < bound) {
+    // Short buffer: the exact length is only known after conversion
+    std::string scratch(bound, '\0');
+    size_t length = to_chars(scratch.data(), scratch.data() + bound, value).ptr - scratch.data();
+    if (length > static_cast<size_t>(last - first)) {
+      return {last, std::errc::value_too_large};
+    }
+    return {std::copy_n(scratch.data(), length, first), std::errc()};
+  }
+
+  if (value.sign_ == BigInteger::sign::ZERO) {
+    *first = '0';
+    return {first + 1, std::errc()};
+  }
+
+  if (value.sign_ == BigInteger::sign::NEGATIVE) {
+    *first++ = '-';
+  }
+  return {BigInteger::write_decimal(value, first, 0), std::errc()};
+}
+
+std::from_chars_result from_chars(const char* first, const char* last, BigInteger& value) {
+  const char* begin = first;
+  bool negative = (begin != last && *begin == '-');
+  if (negative) {
+    ++begin;
+  }
+
+  const char* end = begin;
+  while (end != last && *end >= '0' && *end <= '9') {
+    ++end;
+  }
+  if (end == begin) {
+    return {first, std::errc::invalid_argument};
+  }
+
+  BigInteger::read_decimal(begin, end - begin, value);
+  if (negative && value.sign_ != BigInteger::sign::ZERO) {
+    value.sign_ = BigInteger::sign::NEGATIVE;
+  }
+  return {end, std::errc()};
+}
+
+// Same split as write_decimal, but every piece up to DECIMAL_CONVERSION_THRESHOLD limbs is converted
+// in a local buffer and handed to the sink right away
+template <class Sink>
+void BigInteger::write_decimal_chunked(const BigInteger& value, size_t width, Sink& sink) {
+  size_t size = value.digits_.size();
+
+  if (size <= DECIMAL_CONVERSION_THRESHOLD) {
+    char buffer[DECIMAL_CONVERSION_THRESHOLD * 10];
+    size_t length = write_decimal(value, buffer, 0) - buffer;
+    if (width > length) {
+      // Padding is written through the same buffer, SIZE zeros at a time at most
+      char zeros[SIZE];
+      std::fill_n(zeros, SIZE, '0');
+      for (size_t padding = width - length; padding > 0;) {
+        size_t count = std::min<size_t>(padding, SIZE);
+        sink(static_cast<const char*>(zeros), count);
+        padding -= count;
+      }
+    }
+    sink(static_cast<const char*>(buffer), length);
+    return;
+  }
+
+  size_t level = 0;
+  while (2 * decimal_power(level + 1).digits_.size() - 1 <= size) {
+    ++level;
+  }
+  size_t low_width = size_t(SIZE) << level;
+
+  auto [high, low] = decimal_divisor(level).divmod(value);
+  write_decimal_chunked(high, (width == 0) ? 0 : width - low_width, sink);
+  write_decimal_chunked(low, low_width, sink);
+}
+
+template <class Sink>
+void to_chars_chunked(const BigInteger& value, Sink&& sink) {
+  if (value.sign_ == BigInteger::sign::ZERO) {
+    sink("0", 1);
+    return;
+  }
+  if (value.sign_ == BigInteger::sign::NEGATIVE) {
+    sink("-", 1);
+  }
+  BigInteger::write_decimal_chunked(value, 0, sink);
+}
+
+// CLASS DECIMALREADER
+
+// Decimal parser fed in pieces of any size (from an istream, network buffers, parts of a mapped
+// file). Digits are collected in blocks of SIZE * 2^BLOCK_LEVEL and equal blocks are merged like a
+// binary counter, which is the divide and conquer of from_chars without holding the whole text.
+class DecimalReader {
+ public:
+  // Consumes the number's characters from the front of chars (a '-' is accepted before the first
+  // digit) and returns the first one that cannot belong to it, chars.end() if it may continue
+  const char* feed(std::span<const char> chars);
+  // True once a character that ends the number has been seen
+  bool done() const;
+  // Stores the number and resets the reader, std::errc::invalid_argument if no digit was read
+  std::errc finish(BigInteger& value);
+
+ private:
+  static const size_t BLOCK_LEVEL = 6;
+  static const size_t BLOCK_LENGTH = size_t(BigInteger::SIZE) << BLOCK_LEVEL;
+
+  // Completed blocks, the levels strictly decrease towards the back
+  std::vector<BigInteger> blocks_;
+  std::vector<size_t> levels_;
+  std::string pending_;
+  bool negative_ = false;
+  bool started_ = false;
+  bool done_ = false;
+
+  void push(BigInteger&& block, size_t level);
+};
+
+void DecimalReader::push(BigInteger&& block, size_t level) {
+  while (!levels_.empty() && levels_.back() == level) {
+    BigInteger high = std::move(blocks_.back());
+    blocks_.pop_back();
+    levels_.pop_back();
+    high *= BigInteger::decimal_power(level);
+    high += block;
+    block = std::move(high);
+    ++level;
+  }
+  blocks_.push_back(std::move(block));
+  levels_.push_back(level);
+}
+
+const char* DecimalReader::feed(std::span<const char> chars) {
+  const char* first = chars.data();
+  const char* last = first + chars.size();
+  if (done_ || first == last) {
+    return first;
+  }
+  if (!started_ && *first == '-') {
+    negative_ = true;
+    ++first;
+  }
+  started_ = true;
+
+  const char* end = first;
+  while (end != last && *end >= '0' && *end <= '9') {
+    ++end;
+  }
+
+  // Whole blocks are read in place, only the pieces around them are buffered
+  while (first != end) {
+    if (pending_.empty() && static_cast<size_t>(end - first) >= BLOCK_LENGTH) {
+      BigInteger block;
+      BigInteger::read_decimal(first, BLOCK_LENGTH, block);
+      push(std::move(block), BLOCK_LEVEL);
+      first += BLOCK_LENGTH;
+      continue;
+    }
+    size_t count = std::min(BLOCK_LENGTH - pending_.size(), static_cast<size_t>(end - first));
+    pending_.append(first, count);
+    first += count;
+    if (pending_.size() == BLOCK_LENGTH) {
+      BigInteger block;
+      BigInteger::read_decimal(pending_.data(), BLOCK_LENGTH, block);
+      push(std::move(block), BLOCK_LEVEL);
+      pending_.clear();
+    }
+  }
+
+  done_ = (end != last);
+  return end;
+}
+
+bool DecimalReader::done() const { return done_; }
+
+std::errc DecimalReader::finish(BigInteger& value) {
+  bool valid = !pending_.empty() || !blocks_.empty();
+  if (valid) {
+    // The tail goes below the blocks, which are added from the shortest one up
+    BigInteger result, multiplier = 1;
+    if (pending_.empty()) {
+      result = 0;
+    } else {
+      BigInteger::read_decimal(pending_.data(), pending_.size(), result);
+      multiplier = power(BigInteger(10), static_cast<unsigned long long>(pending_.size()));
+    }
+    while (!blocks_.empty()) {
+      result.addmul(blocks_.back(), multiplier);
+      if (blocks_.size() > 1) {
+        multiplier *= BigInteger::decimal_power(levels_.back());
+      }
+      blocks_.pop_back();
+      levels_.pop_back();
+    }
+    if (negative_ && result.sign_ != BigInteger::sign::ZERO) {
+      result.sign_ = BigInteger::sign::NEGATIVE;
+    }
+    value = std::move(result);
+  }
+
+  pending_.clear();
+  negative_ = started_ = done_ = false;
+  return valid ? std::errc() : std::errc::invalid_argument;
+}
+
+// Stream input/output
+
+std::ostream& operator<<(std::ostream& out, const BigInteger& big_integer) {
+  if (out.width() != 0) {
+    // Padding needs the full length up front
+    return out << big_integer.toString();
+  }
+  to_chars_chunked(big_integer, [&out](const char* data, size_t size) { out.write(data, static_cast<std::streamsize>(size)); });
+  return out;
+}
+
+// Reads like the built-in integer extraction: leading whitespace is skipped and the number ends at
+// the first character that cannot continue it. Characters pass through a fixed-size buffer.
+std::istream& operator>>(std::istream& in, BigInteger& big_integer) {
+  std::istream::sentry sentry(in);
+  if (!sentry) {
+    return in;
+  }
+
+  DecimalReader reader;
+  std::streambuf* buffer = in.rdbuf();
+  char chunk[4096];
+  size_t count = 0;
+  int character = buffer->sgetc();
+  if (character == '-') {
+    chunk[count++] = '-';
+    character = buffer->snextc();
+  }
+  while (character != std::char_traits<char>::eof() && character >= '0' && character <= '9') {
+    chunk[count++] = static_cast<char>(character);
+    character = buffer->snextc();
+    if (count == sizeof(chunk)) {
+      reader.feed(std::span<const char>(chunk, count));
+      count = 0;
+    }
+  }
+  reader.feed(std::span<const char>(chunk, count));
+
+  if (character == std::char_traits<char>::eof()) {
+    in.setstate(std::ios_base::eofbit);
+  }
+  if (reader.finish(big_integer) != std::errc()) {
+    in.setstate(std::ios_base::failbit);
+  }
+  return in;
+}
+
+// Modular exponentiation
+
+BigInteger powmod(const BigInteger& value, const BigInteger& pow, const BigInteger& modulus) {
+  return BigInteger::with_scratch([&]() -> BigInteger {
+    BigInteger magnitude = abs(modulus);
+    if (magnitude.sign_ == BigInteger::sign::ZERO) {
+      throw std::domain_error("powmod: zero modulus");
+    }
+    if (magnitude == 1) {
+      return 0;
+    }
+    if (pow.sign_ == BigInteger::sign::ZERO) {
+      return 1;
+    }
+
+    BigInteger base = value % magnitude;
+    if (pow.sign_ == BigInteger::sign::NEGATIVE) {
+      BigInteger inverse, unused;
+      if (gcdext(base, magnitude, inverse, unused) != 1) {
+        throw std::domain_error("powmod: value is not invertible modulo modulus");
+      }
+      base = inverse % magnitude;
+    }
+    if (base.sign_ == BigInteger::sign::NEGATIVE) {
+      base += magnitude;
+    }
+
+    std::vector<bool> bits = BigInteger::exponent_bits(pow);
 
-  void remove_leading_zeroes();
+    size_t size = magnitude.digits_.size();
+    BigInteger::limb low = std::as_const(magnitude.digits_)[0];
+    if (low % 2 == 0 || size > BigInteger::MONTGOMERY_THRESHOLD) {
+      BigDivisor reducer(magnitude);
+      auto multiply = [&reducer](BigInteger& target, const BigInteger& other) { target = reducer.mod(target * other); };
+      auto square_in_place = [&reducer](BigInteger& target) { target = reducer.mod(square(target)); };
+      return power_sliding_window(base, bits, multiply, square_in_place);
+    }
 
-  friend bool operator==(const BigInteger& first, const BigInteger& second);
-  friend bool operator<(const BigInteger& first, const BigInteger& second);
+    // Values are kept in Montgomery form x * BASE^size mod modulus
+    BigInteger::limb inverse = BigInteger::montgomery_inverse(low);
+    const BigInteger::limb* modulus_limbs = std::as_const(magnitude.digits_).data();
+    LimbVector product(2 * size + 1);
 
-  friend BigInteger find_quotient(BigInteger left, BigInteger right, const BigInteger& number, const BigInteger& divider);
-};
+    auto reduce = [&](BigInteger& target) {
+      BigInteger::montgomery_reduce(product.data(), modulus_limbs, size, inverse);
+      LimbVector limbs(product.begin() + size, product.begin() + 2 * size);
+      target.set_magnitude(limbs, BigInteger::sign::POSITIVE);
+    };
+    auto multiply = [&](BigInteger& target, const BigInteger& other) {
+      std::fill(product.begin(), product.end(), 0);
+      if (target.sign_ != BigInteger::sign::ZERO && other.sign_ != BigInteger::sign::ZERO) {
+        BigInteger::multiply_limbs(std::as_const(target.digits_).data(), target.digits_.size(), other.digits_.data(), other.digits_.size(), product.data());
+      }
+      reduce(target);
+    };
+    auto square_in_place = [&](BigInteger& target) {
+      std::fill(product.begin(), product.end(), 0);
+      if (target.sign_ != BigInteger::sign::ZERO) {
+        BigInteger::square_limbs(std::as_const(target.digits_).data(), target.digits_.size(), product.data());
+      }
+      reduce(target);
+    };
 
-// Declaration of operators
+    BigInteger result = power_sliding_window(BigInteger::shift_limbs(base, size) % magnitude, bits, multiply, square_in_place);
+    multiply(result, 1);
+    return result;
+  });
+}
 
-BigInteger operator+(const BigInteger& first, const BigInteger& second);
-BigInteger operator-(const BigInteger& first, const BigInteger& second);
-BigInteger operator*(const BigInteger& first, const BigInteger& second);
-BigInteger operator/(const BigInteger& first, const BigInteger& second);
-BigInteger operator%(const BigInteger& first, const BigInteger& second);
+// CLASS FIXEDBIGINTEGER
 
-bool operator==(const BigInteger& first, const BigInteger& second);
-bool operator<(const BigInteger& first, const BigInteger& second);
-bool operator!=(const BigInteger& first, const BigInteger& second);
-bool operator>=(const BigInteger& first, const BigInteger& second);
-bool operator>(const BigInteger& first, const BigInteger& second);
-bool operator<=(const BigInteger& first, const BigInteger& second);
+// Integer with a magnitude below 2^Bits, stored as sign and magnitude like BigInteger but in a
+// std::array, so values never touch the heap and every operation is constexpr. Magnitudes that reach
+// 2^Bits wrap modulo 2^Bits. Addition, multiplication and the conversions loop over the full width,
+// so their bounds are compile-time constants the compiler can unroll.
+template <size_t Bits>
+class FixedBigInteger {
+  static_assert(Bits > 0 && Bits % mpn::LIMB_BITS == 0, "FixedBigInteger width must be a positive multiple of the limb size");
 
-std::ostream& operator<<(std::ostream& out, const BigInteger& big_integer);
-std::istream& operator>>(std::istream& in, BigInteger& big_integer);
+ public:
+  constexpr FixedBigInteger(): limbs_{}, sign_(sign::ZERO) {}
+  constexpr FixedBigInteger(long long num);
+  // Digits up to the first non-digit character, with an optional leading '-'
+  constexpr explicit FixedBigInteger(std::string_view str);
+  // Widening is implicit, narrowing keeps the magnitude modulo 2^Bits
+  template <size_t OtherBits>
+  constexpr explicit(OtherBits > Bits) FixedBigInteger(const FixedBigInteger<OtherBits>& other);
+  // Keeps the magnitude modulo 2^Bits. Takes exactly a BigInteger, a string must not reach it through
+  // BigInteger's implicit string constructor.
+  template <std::same_as<BigInteger> Dynamic>
+  explicit FixedBigInteger(const Dynamic& value);
 
-BigInteger operator""_bi(unsigned long long x);
+  constexpr FixedBigInteger& operator+=(const FixedBigInteger& other);
+  constexpr FixedBigInteger& operator-=(const FixedBigInteger& other);
+  constexpr FixedBigInteger& operator*=(const FixedBigInteger& other);
+  constexpr FixedBigInteger& operator/=(const FixedBigInteger& other);
+  constexpr FixedBigInteger& operator%=(const FixedBigInteger& other);
 
-// Additional functions
+  constexpr FixedBigInteger operator-() const;
+  constexpr FixedBigInteger& operator++();
+  constexpr FixedBigInteger operator++(int);
+  constexpr FixedBigInteger& operator--();
+  constexpr FixedBigInteger operator--(int);
+  constexpr explicit operator bool() const;
+  // Narrowing conversion, false if the value does not fit into long long
+  constexpr bool toLongLong(long long& result) const;
+  explicit operator BigInteger() const;
 
-BigInteger abs(const BigInteger& bi) {
-  if (bi < 0) {
-    return -bi;
-  }
-  return bi;
-}
+  constexpr std::string toString() const;
 
-void BigInteger::remove_leading_zeroes() {
-  while (digits_.back() == 0 && digits_.size() > 1) {
-    digits_.pop_back();
-  }
-}
+  friend constexpr FixedBigInteger operator+(FixedBigInteger first, const FixedBigInteger& second) { return first += second; }
+  friend constexpr FixedBigInteger operator-(FixedBigInteger first, const FixedBigInteger& second) { return first -= second; }
+  friend constexpr FixedBigInteger operator*(FixedBigInteger first, const FixedBigInteger& second) { return first *= second; }
+  friend constexpr FixedBigInteger operator/(FixedBigInteger first, const FixedBigInteger& second) { return first /= second; }
+  friend constexpr FixedBigInteger operator%(FixedBigInteger first, const FixedBigInteger& second) { return first %= second; }
 
-BigInteger power(const BigInteger& value, int pow) {
-  if (pow == 0) {
-    return 1;
+  friend constexpr bool operator==(const FixedBigInteger& first, const FixedBigInteger& second) {
+    return first.sign_ == second.sign_ && first.limbs_ == second.limbs_;
   }
-
-  if (pow % 2 == 1) {
-    return value * power(value, pow - 1);
+  friend constexpr std::strong_ordering operator<=>(const FixedBigInteger& first, const FixedBigInteger& second) {
+    if (first.sign_ != second.sign_) {
+      return first.sign_ <=> second.sign_;
+    }
+    int result = compare_magnitudes(first.limbs_, second.limbs_);
+    return (first.sign_ == sign::NEGATIVE) ? 0 <=> result : result <=> 0;
   }
 
-  return power((value * value), pow / 2);
-}
+ private:
+  using limb = mpn::limb;
+  using double_limb = mpn::double_limb;
+  using magnitude = std::array<limb, Bits / mpn::LIMB_BITS>;
 
-BigInteger find_quotient(BigInteger left, BigInteger right, const BigInteger& number, const BigInteger& divider) {
-  BigInteger sum;
-  BigInteger middle;
+  static constexpr int LIMB_BITS = mpn::LIMB_BITS;
+  static constexpr size_t LIMBS = Bits / mpn::LIMB_BITS;
 
-  while (right - left > 1) {
-    sum = right + left;
-    middle = sum.digits_.front() / 2;
+  // Decimal conversion works in chunks of SIZE digits
+  static constexpr limb DECIMAL_BASE = 1'000'000'000;
+  static constexpr int SIZE = 9;
 
-    for (size_t i = 1; i < sum.digits_.size(); ++i) {
-      middle += 5 * power(10, BigInteger::SIZE * i - 1) * sum.digits_[i];
-    }
+  enum class sign : int8_t {
+    NEGATIVE = -1,
+    ZERO = 0,
+    POSITIVE = 1
+  };
 
-    if (middle * divider == number) {
-      return middle;
-    }
+  magnitude limbs_;
+  sign sign_;
 
-    if (middle * divider > number) {
-      right = middle;
-      continue;
-    }
+  constexpr void set_sign(bool negative);
+  constexpr void add_signed(const FixedBigInteger& other, bool subtract);
+  constexpr void multiply_add(limb multiplier, limb addend);
+  constexpr limb divide_by_limb(limb divider);
 
-    left = middle;
-  }
-  return left;
-}
+  static constexpr size_t used_limbs(const magnitude& value);
+  static constexpr int compare_magnitudes(const magnitude& first, const magnitude& second);
+  static constexpr void divide(const FixedBigInteger& dividend, const FixedBigInteger& divider, FixedBigInteger* quotient, FixedBigInteger* remainder);
+
+  template <size_t OtherBits>
+  friend class FixedBigInteger;
+  template <char... Chars>
+  friend struct IntegerLiteral;
+};
+
+template <size_t Bits>
+std::ostream& operator<<(std::ostream& out, const FixedBigInteger<Bits>& value);
+template <size_t Bits>
+std::istream& operator>>(std::istream& in, FixedBigInteger<Bits>& value);
+
+// Compile-time integer literal as the narrowest FixedBigInteger holding it, so it can constant-initialize
+// globals. Accepts the same forms as _bi.
+template <char... Chars>
+constexpr auto operator""_fbi();
 
 // Constructors
 
-BigInteger::BigInteger(long long num) {
-  sign_ = num > 0 ? (sign::POSITIVE) : (num == 0 ? sign::ZERO : sign::NEGATIVE);
-  num *= static_cast<int>(sign_);
+template <size_t Bits>
+constexpr FixedBigInteger<Bits>::FixedBigInteger(long long num): limbs_{}, sign_(sign::ZERO) {
+  unsigned long long magnitude = (num < 0) ? 0ULL - static_cast<unsigned long long>(num) : num;
+  for (size_t i = 0; i < LIMBS && i * LIMB_BITS < 64; ++i) {
+    limbs_[i] = static_cast<limb>(magnitude >> (i * LIMB_BITS));
+  }
+  set_sign(num < 0);
+}
 
-  if (num == 0) {
-    digits_.push_back(0);
-  } else {
-    while (num > 0) {
-      int digit = num % BASE;
-      digits_.push_back(digit);
-      num /= BASE;
+template <size_t Bits>
+constexpr FixedBigInteger<Bits>::FixedBigInteger(std::string_view str): FixedBigInteger() {
+  bool negative = !str.empty() && str[0] == '-';
+  size_t end = negative ? 1 : 0;
+  while (end < str.size() && str[end] >= '0' && str[end] <= '9') {
+    ++end;
+  }
+
+  size_t position = negative ? 1 : 0;
+  while (position < end) {
+    size_t length = std::min<size_t>(SIZE, end - position);
+    limb chunk = 0;
+    limb multiplier = 1;
+    for (size_t i = 0; i < length; ++i) {
+      chunk = chunk * 10 + static_cast<limb>(str[position + i] - '0');
+      multiplier *= 10;
     }
+    multiply_add(multiplier, chunk);
+    position += length;
   }
+  set_sign(negative);
 }
 
-BigInteger::BigInteger(const std::string& str) {
-  if (str[0] == '-') {
-    sign_ = sign::NEGATIVE;
+template <size_t Bits>
+template <size_t OtherBits>
+constexpr FixedBigInteger<Bits>::FixedBigInteger(const FixedBigInteger<OtherBits>& other): limbs_{}, sign_(sign::ZERO) {
+  for (size_t i = 0; i < LIMBS && i < FixedBigInteger<OtherBits>::LIMBS; ++i) {
+    limbs_[i] = other.limbs_[i];
+  }
+  set_sign(other.sign_ == FixedBigInteger<OtherBits>::sign::NEGATIVE);
+}
 
-    for (size_t i = str.size(); i > SIZE; i -= SIZE) {
-      digits_.push_back(stoi(str.substr(i - SIZE, SIZE)));
-    }
+template <size_t Bits>
+template <std::same_as<BigInteger> Dynamic>
+FixedBigInteger<Bits>::FixedBigInteger(const Dynamic& value): limbs_{}, sign_(sign::ZERO) {
+  size_t size = std::min(LIMBS, value.digits_.size());
+  std::copy(value.digits_.begin(), value.digits_.begin() + size, limbs_.begin());
+  set_sign(value.sign_ == BigInteger::sign::NEGATIVE);
+}
 
-    if ((str.size() - 1) % SIZE != 0) {
-      digits_.push_back(stoi(str.substr(1, str.size() - 1 - digits_.size() * SIZE)));
-    }
+// Helpers
 
-  } else if (str[0] == '0') {
+// Sign for the current magnitude, zero whenever the magnitude is
+template <size_t Bits>
+constexpr void FixedBigInteger<Bits>::set_sign(bool negative) {
+  if (used_limbs(limbs_) == 0) {
     sign_ = sign::ZERO;
-    digits_.push_back(0);
-
   } else {
-    sign_ = sign::POSITIVE;
+    sign_ = negative ? sign::NEGATIVE : sign::POSITIVE;
+  }
+}
 
-    for (size_t i = str.size(); i >= SIZE; i -= SIZE) {
-      digits_.push_back(stoi(str.substr(i - SIZE, SIZE)));
-    }
+template <size_t Bits>
+constexpr size_t FixedBigInteger<Bits>::used_limbs(const magnitude& value) {
+  size_t size = LIMBS;
+  while (size > 0 && value[size - 1] == 0) {
+    --size;
+  }
+  return size;
+}
 
-    if (str.size() % SIZE != 0) {
-      digits_.push_back(stoi(str.substr(0, str.size() - digits_.size() * SIZE)));
+template <size_t Bits>
+constexpr int FixedBigInteger<Bits>::compare_magnitudes(const magnitude& first, const magnitude& second) {
+  for (size_t i = LIMBS; i-- > 0;) {
+    if (first[i] != second[i]) {
+      return first[i] < second[i] ? -1 : 1;
     }
   }
+  return 0;
 }
 
-// Comparison operators
-
-bool operator==(const BigInteger& first, const BigInteger& second) {
-  if (first.sign_ != second.sign_) {
-    return false;
+// Magnitude becomes |*this| * multiplier + addend
+template <size_t Bits>
+constexpr void FixedBigInteger<Bits>::multiply_add(limb multiplier, limb addend) {
+  double_limb carry = addend;
+  for (size_t i = 0; i < LIMBS; ++i) {
+    carry += double_limb(limbs_[i]) * multiplier;
+    limbs_[i] = static_cast<limb>(carry);
+    carry >>= LIMB_BITS;
   }
+}
 
-  if (first.sign_ == BigInteger::sign::ZERO) {
-    return true;
+// Divides the magnitude in place, returns the remainder
+template <size_t Bits>
+constexpr typename FixedBigInteger<Bits>::limb FixedBigInteger<Bits>::divide_by_limb(limb divider) {
+  double_limb remainder = 0;
+  for (size_t i = LIMBS; i-- > 0;) {
+    remainder = (remainder << LIMB_BITS) | limbs_[i];
+    limbs_[i] = static_cast<limb>(remainder / divider);
+    remainder %= divider;
   }
-
-  return first.digits_ == second.digits_;
+  return static_cast<limb>(remainder);
 }
 
-bool operator<(const BigInteger& first, const BigInteger& second) {
-  if (first.sign_ != second.sign_) {
-    return first.sign_ < second.sign_;
-  }
+// Calculation operators
 
-  if (first.digits_.size() != second.digits_.size()) {
-    return (first.digits_.size() < second.digits_.size()) == (first.sign_ == BigInteger::sign::POSITIVE);
+// Adds other (or -other when subtracting): equal signs add the magnitudes, otherwise the smaller
+// magnitude is taken from the larger one
+template <size_t Bits>
+constexpr void FixedBigInteger<Bits>::add_signed(const FixedBigInteger& other, bool subtract) {
+  if (other.sign_ == sign::ZERO) {
+    return;
+  }
+  bool other_negative = (other.sign_ == sign::NEGATIVE) != subtract;
+  if (sign_ == sign::ZERO) {
+    limbs_ = other.limbs_;
+    sign_ = other_negative ? sign::NEGATIVE : sign::POSITIVE;
+    return;
   }
 
-  for (size_t i = 0; i < first.digits_.size(); ++i) {
-    if (first.digits_[first.digits_.size() - i - 1] != second.digits_[first.digits_.size() - i - 1]) {
-      return first.digits_[first.digits_.size() - i - 1] < second.digits_[first.digits_.size() - i - 1];
+  bool negative = (sign_ == sign::NEGATIVE);
+  if (negative == other_negative) {
+    limb carry = 0;
+    for (size_t i = 0; i < LIMBS; ++i) {
+      double_limb sum = double_limb(limbs_[i]) + other.limbs_[i] + carry;
+      limbs_[i] = static_cast<limb>(sum);
+      carry = static_cast<limb>(sum >> LIMB_BITS);
     }
+    set_sign(negative);
+    return;
   }
 
-  return false;
+  bool swap = compare_magnitudes(limbs_, other.limbs_) < 0;
+  const magnitude& larger = swap ? other.limbs_ : limbs_;
+  const magnitude& smaller = swap ? limbs_ : other.limbs_;
+  magnitude difference{};
+  limb borrow = 0;
+  for (size_t i = 0; i < LIMBS; ++i) {
+    double_limb subtrahend = double_limb(smaller[i]) + borrow;
+    difference[i] = static_cast<limb>(larger[i] - subtrahend);
+    borrow = (larger[i] < subtrahend) ? 1 : 0;
+  }
+  limbs_ = difference;
+  set_sign(swap ? other_negative : negative);
 }
 
-bool operator!=(const BigInteger& first, const BigInteger& second) {
-  return !(first == second);
+template <size_t Bits>
+constexpr FixedBigInteger<Bits>& FixedBigInteger<Bits>::operator+=(const FixedBigInteger& other) {
+  add_signed(other, false);
+  return *this;
 }
 
-bool operator>=(const BigInteger& first, const BigInteger& second) {
-  return !(first < second);
+template <size_t Bits>
+constexpr FixedBigInteger<Bits>& FixedBigInteger<Bits>::operator-=(const FixedBigInteger& other) {
+  add_signed(other, true);
+  return *this;
 }
 
-bool operator>(const BigInteger& first, const BigInteger& second) {
-  return second < first;
+// Schoolbook multiplication, limbs of the product past the width are never formed
+template <size_t Bits>
+constexpr FixedBigInteger<Bits>& FixedBigInteger<Bits>::operator*=(const FixedBigInteger& other) {
+  magnitude product{};
+  for (size_t i = 0; i < LIMBS; ++i) {
+    double_limb carry = 0;
+    for (size_t j = 0; i + j < LIMBS; ++j) {
+      carry += double_limb(limbs_[i]) * other.limbs_[j] + product[i + j];
+      product[i + j] = static_cast<limb>(carry);
+      carry >>= LIMB_BITS;
+    }
+  }
+  limbs_ = product;
+  set_sign((sign_ == sign::NEGATIVE) != (other.sign_ == sign::NEGATIVE));
+  return *this;
 }
 
-bool operator<=(const BigInteger& first, const BigInteger& second) {
-  return !(second < first);
+// Truncating division with the remainder taking the sign of the dividend, like BigInteger
+template <size_t Bits>
+constexpr FixedBigInteger<Bits>& FixedBigInteger<Bits>::operator/=(const FixedBigInteger& other) {
+  divide(*this, other, this, nullptr);
+  return *this;
 }
 
-// Calculation binary operators
-
-BigInteger& BigInteger::operator+=(const BigInteger& other) {
-  if (sign_ == other.sign_) {
-    int carry = 0;
-	size_t max_size = std::max(digits_.size(), other.digits_.size());
-
-	for (size_t i = 0; i < max_size || carry > 0; ++i) {
-	  if (i >= max_size && carry > 0) {
-		digits_.push_back(carry);
-		break;
-	  }
-
-	  long sum;
-	  if (digits_.size() >= other.digits_.size()) {
-		sum = (i < other.digits_.size()) ? (digits_[i] + other.digits_[i] + carry) : (digits_[i] + carry);
-	  } else {
-		sum = (i < digits_.size()) ? (digits_[i] + other.digits_[i] + carry) : (other.digits_[i] + carry);
-	  }
-
-	  carry = sum / BASE;
-	  if (digits_.size() >= other.digits_.size() || i < digits_.size()) {
-		digits_[i] = sum % BASE;
-	  } else {
-		digits_.push_back(sum % BASE);
-	  }
-	}
-
-    remove_leading_zeroes();
-    return *this;
-  } else if (*this == 0) {
+template <size_t Bits>
+constexpr FixedBigInteger<Bits>& FixedBigInteger<Bits>::operator%=(const FixedBigInteger& other) {
+  divide(*this, other, nullptr, this);
+  return *this;
+}
 
-    *this = other;
-    remove_leading_zeroes();
-    return *this;
+// Knuth's Algorithm D on the used limbs, with a single-limb pass for short dividers. A zero divider
+// throws std::domain_error, which makes division by zero a compile error in constant expressions.
+template <size_t Bits>
+constexpr void FixedBigInteger<Bits>::divide(const FixedBigInteger& dividend, const FixedBigInteger& divider, FixedBigInteger* quotient, FixedBigInteger* remainder) {
+  size_t divider_size = used_limbs(divider.limbs_);
+  if (divider_size == 0) {
+    throw std::domain_error("division by zero");
   }
+  bool quotient_negative = (dividend.sign_ == sign::NEGATIVE) != (divider.sign_ == sign::NEGATIVE);
+  bool remainder_negative = (dividend.sign_ == sign::NEGATIVE);
+  size_t dividend_size = used_limbs(dividend.limbs_);
 
-  return *this -= -other;
-}
+  FixedBigInteger result;
+  FixedBigInteger rest;
+  if (compare_magnitudes(dividend.limbs_, divider.limbs_) < 0) {
+    rest.limbs_ = dividend.limbs_;
+  } else if (divider_size == 1) {
+    result.limbs_ = dividend.limbs_;
+    rest.limbs_[0] = result.divide_by_limb(divider.limbs_[0]);
+  } else {
+    int shift = std::countl_zero(divider.limbs_[divider_size - 1]);
+    std::array<limb, LIMBS + 1> current{};
+    magnitude normalized{};
+    for (size_t i = 0; i < divider_size; ++i) {
+      normalized[i] = (divider.limbs_[i] << shift) | (shift == 0 || i == 0 ? 0 : divider.limbs_[i - 1] >> (LIMB_BITS - shift));
+    }
+    for (size_t i = 0; i <= dividend_size; ++i) {
+      limb low = (i < dividend_size) ? dividend.limbs_[i] << shift : 0;
+      limb high = (shift == 0 || i == 0) ? 0 : dividend.limbs_[i - 1] >> (LIMB_BITS - shift);
+      current[i] = low | high;
+    }
 
-BigInteger& BigInteger::operator-=(const BigInteger& other) {
-  if (sign_ == other.sign_) {
-    int carry = 0;
-	size_t max_size = std::max(digits_.size(), other.digits_.size());
-	if (abs(*this) == abs(other)) {
-	  *this = 0;
-	} else { // Change abs() to multiplication on sign
-	  if (abs(*this) < abs(other)) {
-		sign_ = (sign_ == BigInteger::sign::NEGATIVE) ? BigInteger::sign::POSITIVE : BigInteger::sign::NEGATIVE;
-	  }
-      for (size_t i = 0; i < max_size || carry != 0; ++i) {
-		long diff;
-		if (digits_.size() >= other.digits_.size()) {
-		  diff = (i < other.digits_.size()) ? (digits_[i] - other.digits_[i] + carry) : (digits_[i] + carry);
-		} else {
-		  diff = (i < digits_.size() ? other.digits_[i] - digits_[i] + carry : other.digits_[i] + carry);
-		}
-        carry = 0;
-        if (diff < 0) {
-          carry = -1;
-          diff += BASE;
+    double_limb top = normalized[divider_size - 1];
+    double_limb next = normalized[divider_size - 2];
+    for (size_t j = dividend_size - divider_size + 1; j-- > 0;) {
+      double_limb numerator = (double_limb(current[j + divider_size]) << LIMB_BITS) | current[j + divider_size - 1];
+      double_limb estimate = numerator / top;
+      double_limb rest_estimate = numerator % top;
+      while (estimate >> LIMB_BITS != 0 ||
+             estimate * next > ((rest_estimate << LIMB_BITS) | current[j + divider_size - 2])) {
+        --estimate;
+        rest_estimate += top;
+        if (rest_estimate >> LIMB_BITS != 0) {
+          break;
         }
-		if (digits_.size() >= other.digits_.size() || i < digits_.size()) {
-		  digits_[i] = diff;
-		} else {
-		  digits_.push_back(diff);
-		}
       }
-    }
-    remove_leading_zeroes();
-    return *this;
-  } else if (other == 0) {
-    remove_leading_zeroes();
-    return *this;
-  }
-  return *this += -other;
-}
 
-BigInteger& BigInteger::operator*=(const BigInteger& other) {
-  if (abs(*this) > abs(other)) {
-    std::vector<int> copy = digits_;
-    int sign = static_cast<int>(sign_) * static_cast<int>(other.sign_);
-    long long carry = 0;
-    *this = 0;
-    sign_ = sign::ZERO;
-    for (size_t i = 0; i < other.digits_.size(); ++i) {
-      BigInteger level = 0;
-      level.digits_.clear();
-      for (size_t j = 0; j < i; ++j) {
-        level.digits_.push_back(0);
+      // current[j ..= j + divider_size] -= estimate * normalized
+      double_limb carry = 0;
+      limb borrow = 0;
+      for (size_t i = 0; i <= divider_size; ++i) {
+        carry += (i < divider_size) ? estimate * normalized[i] : 0;
+        limb product = static_cast<limb>(carry);
+        carry >>= LIMB_BITS;
+        limb value = current[j + i];
+        current[j + i] = value - product - borrow;
+        borrow = (value < product || (value == product && borrow != 0)) ? 1 : 0;
       }
-      for (size_t j = 0; j < copy.size() || carry > 0; ++j) {
-        if (j >= copy.size() && carry > 0) {
-          level.digits_.push_back(carry);
-          break;
+      if (borrow != 0) {
+        --estimate;
+        limb add_carry = 0;
+        for (size_t i = 0; i <= divider_size; ++i) {
+          double_limb sum = double_limb(current[j + i]) + (i < divider_size ? normalized[i] : 0) + add_carry;
+          current[j + i] = static_cast<limb>(sum);
+          add_carry = static_cast<limb>(sum >> LIMB_BITS);
         }
-        long long number = static_cast<long long>(other.digits_[i]) * static_cast<long long>(copy[j]) + carry;
-        carry = number / BASE;
-        level.digits_.push_back(number % BASE);
-        level.sign_ = sign::POSITIVE;
       }
-      *this += level;
-      carry = 0;
+      result.limbs_[j] = static_cast<limb>(estimate);
     }
-    remove_leading_zeroes();
-    sign_ = (sign == 0) ? (sign::ZERO) : (sign == 1 ? sign::POSITIVE : sign::NEGATIVE);
-    return *this;
-  }
-  std::vector<int> copy = digits_;
-  int sign = static_cast<int>(sign_) * static_cast<int>(other.sign_);
-  long long carry = 0;
-  *this = 0;
-  sign_ = sign::ZERO;
-  for (size_t i = 0; i < copy.size(); ++i) {
-    BigInteger level = 0;
-    level.digits_.clear();
-    for (size_t j = 0; j < i; ++j) {
-      level.digits_.push_back(0);
-    }
-    for (size_t j = 0; j < other.digits_.size() || carry > 0; ++j) {
-      if (j >= other.digits_.size() && carry > 0) {
-        level.digits_.push_back(carry);
-        break;
-      }
-      long long number = static_cast<long long>(copy[i]) * static_cast<long long>(other.digits_[j]) + carry;
-      carry = number / BASE;
-      level.digits_.push_back(number % BASE);
-      level.sign_ = sign::POSITIVE;
+
+    for (size_t i = 0; i < divider_size; ++i) {
+      rest.limbs_[i] = (current[i] >> shift) | (shift == 0 ? 0 : current[i + 1] << (LIMB_BITS - shift));
     }
-    *this += level;
-    carry = 0;
   }
-  remove_leading_zeroes();
-  sign_ = (sign == 0) ? (sign::ZERO) : (sign == 1 ? sign::POSITIVE : sign::NEGATIVE);
-  return *this;
-}
 
-BigInteger& BigInteger::operator/=(const BigInteger& other) {
-  int sign = static_cast<int>(sign_) * static_cast<int>(other.sign_);
-  if (sign_ == sign::ZERO) {
-    return *this;
-  }
-  if (abs(*this) < abs(other)) {
-    *this = 0;
-    remove_leading_zeroes();
-    return *this;
-  }
-  if (abs(other) == 1) {
-    sign_ = (sign == 0) ? (sign::ZERO) : (sign > 0 ? sign::POSITIVE : sign::NEGATIVE);
-    return *this;
+  if (quotient != nullptr) {
+    result.set_sign(quotient_negative);
+    *quotient = result;
   }
-  BigInteger quotient = 0;
-  BigInteger digit;
-  BigInteger dividend = digits_.back();
-  for (int i = digits_.size() - 1; i >= 0;) {
-    while (dividend < abs(other) && i >= 0) {
-      --i;
-      if (i < 0) {
-        break;
-      }
-      quotient *= BASE;
-      dividend *= BASE;
-      dividend += digits_[i];
-    }
-    digit = find_quotient(0, BASE - 1, dividend, abs(other));
-    quotient += digit;
-    dividend -= abs(other) * digit;
-    if (i <= 0) {
-      break;
-    }
+  if (remainder != nullptr) {
+    rest.set_sign(remainder_negative);
+    *remainder = rest;
   }
-  *this = quotient;
-  sign_ = (sign == 0) ? (sign::ZERO) : (sign > 0 ? sign::POSITIVE : sign::NEGATIVE);
-  remove_leading_zeroes();
-  return *this;
-}
-
-BigInteger& BigInteger::operator%=(const BigInteger& other) { return *this -= (*this / other) * other; }
-
-BigInteger operator+(const BigInteger& first, const BigInteger& second) {
-  BigInteger result = first;
-  result += second;
-  return result;
 }
 
-BigInteger operator-(const BigInteger& first, const BigInteger& second) {
-  BigInteger result = first;
-  result -= second;
-  return result;
-}
+// Unary operators
 
-BigInteger operator*(const BigInteger& first, const BigInteger& second) {
-  BigInteger result = first;
-  result *= second;
+template <size_t Bits>
+constexpr FixedBigInteger<Bits> FixedBigInteger<Bits>::operator-() const {
+  FixedBigInteger result = *this;
+  result.sign_ = static_cast<sign>(-static_cast<int>(sign_));
   return result;
 }
 
-BigInteger operator/(const BigInteger& first, const BigInteger& second) {
-  BigInteger result = first;
-  result /= second;
-  return result;
+template <size_t Bits>
+constexpr FixedBigInteger<Bits>& FixedBigInteger<Bits>::operator++() {
+  return *this += 1;
 }
 
-BigInteger operator%(const BigInteger& first, const BigInteger& second) {
-  BigInteger result = first;
-  result %= second;
-  return result;
+template <size_t Bits>
+constexpr FixedBigInteger<Bits> FixedBigInteger<Bits>::operator++(int) {
+  FixedBigInteger copy = *this;
+  ++*this;
+  return copy;
 }
 
-// Calculation unary operators
-
-BigInteger BigInteger::operator-() const {
-  BigInteger result = *this;
-  result.sign_ = (sign_ == sign::ZERO) ? sign::ZERO : (sign_ == sign::NEGATIVE ? sign::POSITIVE : sign::NEGATIVE);
-  return result;
+template <size_t Bits>
+constexpr FixedBigInteger<Bits>& FixedBigInteger<Bits>::operator--() {
+  return *this -= 1;
 }
 
-BigInteger& BigInteger::operator++() { return (*this += 1); }
-
-BigInteger BigInteger::operator++(int) {
-  BigInteger copy(*this);
-  *this += 1;
+template <size_t Bits>
+constexpr FixedBigInteger<Bits> FixedBigInteger<Bits>::operator--(int) {
+  FixedBigInteger copy = *this;
+  --*this;
   return copy;
 }
 
-BigInteger& BigInteger::operator--() { return (*this -= 1); }
+// Conversions
 
-BigInteger BigInteger::operator--(int) {
-  BigInteger copy(*this);
-  *this -= 1;
-  return copy;
+template <size_t Bits>
+constexpr FixedBigInteger<Bits>::operator bool() const {
+  return sign_ != sign::ZERO;
 }
 
-// Operator bool() & literal suffix
+template <size_t Bits>
+constexpr bool FixedBigInteger<Bits>::toLongLong(long long& result) const {
+  if (used_limbs(limbs_) > 2) {
+    return false;
+  }
 
-BigInteger::operator bool() const {
-  if (sign_ == sign::ZERO) {
+  unsigned long long magnitude = limbs_[0];
+  if (LIMBS > 1) {
+    magnitude |= static_cast<unsigned long long>(limbs_[LIMBS > 1 ? 1 : 0]) << LIMB_BITS;
+  }
+  if (magnitude > (~0ULL >> 1)) {
     return false;
   }
+
+  result = (sign_ == sign::NEGATIVE) ? -static_cast<long long>(magnitude) : static_cast<long long>(magnitude);
   return true;
 }
 
-BigInteger operator""_bi(unsigned long long x) {
-  BigInteger big_integer(x);
-  return big_integer;
+template <size_t Bits>
+FixedBigInteger<Bits>::operator BigInteger() const {
+  BigInteger result;
+  LimbVector limbs(limbs_.data(), limbs_.data() + used_limbs(limbs_));
+  result.set_magnitude(limbs, static_cast<BigInteger::sign>(sign_));
+  return result;
 }
 
-// toString() & input/output operators
-
-std::string BigInteger::toString() const{
-  std::string string;
-
+template <size_t Bits>
+constexpr std::string FixedBigInteger<Bits>::toString() const {
   if (sign_ == sign::ZERO) {
     return "0";
   }
 
+  // Chunks of SIZE digits come out least significant first
+  std::string string;
+  FixedBigInteger rest = *this;
+  while (used_limbs(rest.limbs_) != 0) {
+    limb chunk = rest.divide_by_limb(DECIMAL_BASE);
+    bool last = (used_limbs(rest.limbs_) == 0);
+    for (int i = 0; i < SIZE && (!last || chunk != 0); ++i) {
+      string.push_back(static_cast<char>('0' + chunk % 10));
+      chunk /= 10;
+    }
+  }
   if (sign_ == sign::NEGATIVE) {
     string.push_back('-');
   }
+  std::reverse(string.begin(), string.end());
+  return string;
+}
+
+// Stream input/output
+
+template <size_t Bits>
+std::ostream& operator<<(std::ostream& out, const FixedBigInteger<Bits>& value) {
+  return out << value.toString();
+}
+
+template <size_t Bits>
+std::istream& operator>>(std::istream& in, FixedBigInteger<Bits>& value) {
+  BigInteger read;
+  if (in >> read) {
+    value = FixedBigInteger<Bits>(read);
+  }
+  return in;
+}
 
-  string += std::to_string(digits_.back());
+// CLASS INTEGERLITERAL
 
-  for (int i = digits_.size() - 2; i >= 0; --i) {
-    std::string digit = std::to_string(digits_[i]);
-    std::string gap;
+// Parses the characters of an integer literal at compile time. The magnitude is first read into
+// enough limbs for any literal with that many digits in its radix, BITS then trims it to the limbs
+// actually used.
+template <char... Chars>
+struct IntegerLiteral {
+  using limb = mpn::limb;
+  using double_limb = mpn::double_limb;
 
-    for (size_t j = 0; j < SIZE - digit.size(); ++j) {
-      gap.push_back('0');
+  static constexpr char TEXT[] = {Chars...};
+  static constexpr size_t LENGTH = sizeof...(Chars);
+
+  static constexpr size_t prefix_length() {
+    if (LENGTH > 1 && TEXT[0] == '0') {
+      char kind = TEXT[1];
+      return (kind == 'x' || kind == 'X' || kind == 'b' || kind == 'B') ? 2 : 1;
     }
+    return 0;
+  }
 
-    string += gap;
-    string += digit;
+  static constexpr limb radix() {
+    switch (prefix_length() == 0 ? '\0' : TEXT[1]) {
+      case 'x':
+      case 'X':
+        return 16;
+      case 'b':
+      case 'B':
+        return 2;
+      case '\0':
+        return 10;
+      default:
+        return 8;
+    }
   }
 
-  return string;
-}
+  // Value of character in the literal's radix, radix() for anything that is not a digit of it
+  static constexpr limb digit(char character) {
+    limb value = radix();
+    if (character >= '0' && character <= '9') {
+      value = static_cast<limb>(character - '0');
+    } else if (character >= 'a' && character <= 'f') {
+      value = static_cast<limb>(character - 'a' + 10);
+    } else if (character >= 'A' && character <= 'F') {
+      value = static_cast<limb>(character - 'A' + 10);
+    }
+    return (value < radix()) ? value : radix();
+  }
 
-std::ostream& operator<<(std::ostream& out, const BigInteger& big_integer) {
-  out << big_integer.toString();
-  return out;
+  static constexpr bool valid() {
+    size_t digits = 0;
+    for (size_t i = (radix() == 8) ? 0 : prefix_length(); i < LENGTH; ++i) {
+      if (TEXT[i] != '\'') {
+        if (digit(TEXT[i]) == radix()) {
+          return false;
+        }
+        ++digits;
+      }
+    }
+    return digits > 0;
+  }
+
+  // Digits after the prefix, separators excluded
+  static constexpr size_t digit_count() {
+    size_t digits = 0;
+    for (size_t i = prefix_length(); i < LENGTH; ++i) {
+      digits += (TEXT[i] != '\'') ? 1 : 0;
+    }
+    return digits;
+  }
+
+  // A hexadecimal, octal or binary digit adds 4, 3 or 1 bits, a decimal one at most log2(10) < 10 / 3
+  static constexpr size_t bit_bound() {
+    switch (radix()) {
+      case 16:
+        return 4 * digit_count();
+      case 8:
+        return 3 * digit_count();
+      case 2:
+        return digit_count();
+      default:
+        return digit_count() * 10 / 3 + 1;
+    }
+  }
+
+  static constexpr size_t WIDE_LIMBS = bit_bound() / mpn::LIMB_BITS + 1;
+
+  static constexpr std::array<limb, WIDE_LIMBS> parse() {
+    std::array<limb, WIDE_LIMBS> limbs{};
+    for (size_t i = prefix_length(); i < LENGTH; ++i) {
+      if (TEXT[i] == '\'') {
+        continue;
+      }
+      double_limb carry = digit(TEXT[i]);
+      for (limb& value : limbs) {
+        carry += double_limb(value) * radix();
+        value = static_cast<limb>(carry);
+        carry >>= mpn::LIMB_BITS;
+      }
+    }
+    return limbs;
+  }
+
+  static_assert(valid(), "invalid digit in integer literal");
+
+  static constexpr std::array<limb, WIDE_LIMBS> WIDE = parse();
+
+  static constexpr size_t used_limbs() {
+    size_t size = WIDE_LIMBS;
+    while (size > 1 && WIDE[size - 1] == 0) {
+      --size;
+    }
+    return size;
+  }
+
+  static constexpr size_t BITS = used_limbs() * mpn::LIMB_BITS;
+
+  static constexpr FixedBigInteger<BITS> fixed() {
+    FixedBigInteger<BITS> result;
+    for (size_t i = 0; i < result.LIMBS; ++i) {
+      result.limbs_[i] = WIDE[i];
+    }
+    result.set_sign(false);
+    return result;
+  }
+
+  // Only copies the precomputed limbs
+  static BigInteger dynamic() {
+    BigInteger result;
+    LimbVector limbs(WIDE.data(), WIDE.data() + used_limbs());
+    result.set_magnitude(limbs, BigInteger::sign::POSITIVE);
+    return result;
+  }
+};
+
+template <char... Chars>
+BigInteger operator""_bi() {
+  return IntegerLiteral<Chars...>::dynamic();
 }
 
-std::istream& operator>>(std::istream& in, BigInteger& big_integer) {
-  std::string number;
-  in >> number;
-  big_integer = BigInteger(number);
-  return in;
+template <char... Chars>
+constexpr auto operator""_fbi() {
+  return IntegerLiteral<Chars...>::fixed();
 }
@@ -1,7 +1,15 @@
 #include <algorithm>
+#include <bit>
 #include <cmath>
 #include <compare>
+#include <concepts>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <numeric>
 #include <string>
+#include <tuple>
+#include <utility>
 #include <vector>
 #include <iostream>
 #include "biginteger.h"
@@ -13,25 +21,46 @@ class Rational {
   Rational() = default;
   Rational(int number);
   Rational(const BigInteger& number);
+  // Exact value of a finite binary floating point number
+  template <std::floating_point Float>
+  explicit Rational(Float number);
   Rational(const Rational& other) = default;
+  Rational(Rational&& other) noexcept = default;
   ~Rational() = default;
 
   Rational& operator=(const Rational& other) = default;
+  Rational& operator=(Rational&& other) noexcept = default;
 
   Rational& operator+=(const Rational& other);
   Rational& operator-=(const Rational& other);
   Rational& operator*=(const Rational& other);
   Rational& operator/=(const Rational& other);
 
-  Rational operator-() const;
+  Rational operator-() const&;
+  Rational operator-() &&;
   explicit operator double() const;
+  // Correctly rounded (to nearest, ties to even) floating point value
+  double toDouble() const;
+  long double toLongDouble() const;
 
   std::string toString() const;
   std::string asDecimal(size_t precision = 0) const;
 
+  // Lazy values skip the GCD reduction in arithmetic and are brought to lowest terms only when they
+  // are compared, printed or converted
+  void setLazy(bool lazy);
+  bool isLazy() const;
+
  private:
-  BigInteger numerator_;
-  BigInteger denominator_;
+  // Canonicalization of a lazy value does not change the number, so it may happen in const methods
+  mutable BigInteger numerator_;
+  mutable BigInteger denominator_;
+
+  // Values whose canonical numerator and denominator fit into int64_t are kept in machine words with
+  // a signed numerator, the BigInteger fields are unused then
+  mutable int64_t small_numerator_ = 0;
+  mutable int64_t small_denominator_ = 1;
+  mutable bool small_ = true;
 
   enum class sign : int8_t {
     NEGATIVE = -1,
@@ -39,12 +68,41 @@ class Rational {
     POSITIVE = 1
   };
 
-  sign sign_;
+  sign sign_ = sign::ZERO;
+  bool lazy_ = false;
+  mutable bool canonical_ = true;
+
+  void reduction() const;
+  void canonicalize() const;
+  BigInteger signedNumerator() const;
+  void assign(BigInteger&& numerator, BigInteger&& denominator, bool canonical);
+  Rational& add(const Rational& other, bool subtract);
+
+  void assignSmall(int64_t numerator, int64_t denominator);
+  bool addSmall(const Rational& other, bool subtract);
+  bool multiplySmall(int64_t numerator, int64_t denominator);
+  void promote();
+  void demote() const;
+  static const Rational& asBig(const Rational& value, Rational& storage);
+
+  template <class Float>
+  Float toFloating() const;
+
+  // Continued fraction terms compared before falling back to the exact cross products, the walk is
+  // taken only while the integer parts fit into a machine word and each term costs a linear division
+  static const int CONTINUED_FRACTION_STEPS = 16;
 
-  void reduction();
+  // Decimal chunks cost one pass over the denominator each, so asDecimal() streams them once the
+  // precision reaches this multiple of the denominator size (in limbs) and divides once otherwise
+  static const size_t DECIMAL_STREAMING_RATIO = 200;
+
+  static std::strong_ordering compareMagnitudes(const BigInteger& first_numerator, const BigInteger& first_denominator,
+                                                const BigInteger& second_numerator, const BigInteger& second_denominator);
 
   friend bool operator==(const Rational& first, const Rational& second);
-  friend bool operator<(const Rational& first, const Rational& second);
+  friend std::strong_ordering operator<=>(const Rational& first, const Rational& second);
+
+  friend class DecimalDigits;
 };
 
 // Declaration of operators
@@ -54,57 +112,152 @@ Rational operator-(const Rational& first, const Rational& second);
 Rational operator*(const Rational& first, const Rational& second);
 Rational operator/(const Rational& first, const Rational& second);
 
+// Overloads for expiring operands, the result reuses their storage
+Rational operator+(Rational&& first, const Rational& second);
+Rational operator+(const Rational& first, Rational&& second);
+Rational operator+(Rational&& first, Rational&& second);
+Rational operator-(Rational&& first, const Rational& second);
+Rational operator*(Rational&& first, const Rational& second);
+Rational operator*(const Rational& first, Rational&& second);
+Rational operator*(Rational&& first, Rational&& second);
+Rational operator/(Rational&& first, const Rational& second);
+
 bool operator!=(const Rational& first, const Rational& second);
 bool operator>(const Rational& first, const Rational& second);
 bool operator>=(const Rational& first, const Rational& second);
 bool operator<=(const Rational& first, const Rational& second);
+std::strong_ordering operator<=>(const Rational& first, const Rational& second);
 
 // Additional functions
 
-BigInteger euclid(const BigInteger& first, const BigInteger& second) {
-  if (second == 0) {
-    return first;
+void Rational::reduction() const {
+  if (numerator_ == 0) {
+    denominator_ = 1;
+    return;
   }
 
-  if (second == 1) {
-    return 1;
+  BigInteger divider = gcd(numerator_, denominator_);
+  if (divider != 1) {
+    numerator_ /= divider;
+    denominator_ /= divider;
   }
+}
 
-  return euclid(second, first % second);
+void Rational::canonicalize() const {
+  if (!canonical_) {
+    reduction();
+    canonical_ = true;
+    demote();
+  }
 }
 
-void Rational::reduction() {
-  if (numerator_ == 0) {
-    denominator_ = 1;
-    return;
+BigInteger Rational::signedNumerator() const {
+  return (sign_ == sign::NEGATIVE) ? -numerator_ : numerator_;
+}
+
+// Takes a signed numerator and a positive denominator
+void Rational::assign(BigInteger&& numerator, BigInteger&& denominator, bool canonical) {
+  sign_ = (numerator == 0) ? sign::ZERO : (numerator < 0 ? sign::NEGATIVE : sign::POSITIVE);
+  numerator_ = (sign_ == sign::NEGATIVE) ? -std::move(numerator) : std::move(numerator);
+  denominator_ = (sign_ == sign::ZERO) ? BigInteger(1) : std::move(denominator);
+  canonical_ = canonical || sign_ == sign::ZERO;
+  demote();
+}
+
+// Small values
+
+void Rational::assignSmall(int64_t numerator, int64_t denominator) {
+  small_numerator_ = numerator;
+  small_denominator_ = denominator;
+  small_ = true;
+  sign_ = (numerator == 0) ? sign::ZERO : (numerator < 0 ? sign::NEGATIVE : sign::POSITIVE);
+}
+
+// Henrici's addition on machine words, false if an intermediate overflows
+bool Rational::addSmall(const Rational& other, bool subtract) {
+  int64_t other_numerator = subtract ? -other.small_numerator_ : other.small_numerator_;
+  int64_t divider = std::gcd(small_denominator_, other.small_denominator_);
+  int64_t own_part = small_denominator_ / divider;
+  int64_t first, second, numerator;
+  if (__builtin_mul_overflow(small_numerator_, other.small_denominator_ / divider, &first) ||
+      __builtin_mul_overflow(other_numerator, own_part, &second) ||
+      __builtin_add_overflow(first, second, &numerator) || numerator == INT64_MIN) {
+    return false;
   }
 
-  if (numerator_ % denominator_ == 0) {
-    numerator_ /= denominator_;
-    denominator_ = 1;
-    return;
+  if (numerator == 0) {
+    assignSmall(0, 1);
+    return true;
+  }
+
+  int64_t common = std::gcd(numerator, divider);
+  int64_t denominator;
+  if (__builtin_mul_overflow(own_part, other.small_denominator_ / common, &denominator)) {
+    return false;
+  }
+  assignSmall(numerator / common, denominator);
+  return true;
+}
+
+// Multiplies by numerator / denominator (denominator > 0) with cross GCDs, false on overflow
+bool Rational::multiplySmall(int64_t numerator, int64_t denominator) {
+  if (small_numerator_ == 0 || numerator == 0) {
+    assignSmall(0, 1);
+    return true;
+  }
+
+  int64_t first_divider = std::gcd(small_numerator_, denominator);
+  int64_t second_divider = std::gcd(small_denominator_, numerator);
+  int64_t result_numerator, result_denominator;
+  if (__builtin_mul_overflow(small_numerator_ / first_divider, numerator / second_divider, &result_numerator) ||
+      __builtin_mul_overflow(small_denominator_ / second_divider, denominator / first_divider, &result_denominator) ||
+      result_numerator == INT64_MIN) {
+    return false;
+  }
+  assignSmall(result_numerator, result_denominator);
+  return true;
+}
+
+void Rational::promote() {
+  if (small_) {
+    numerator_ = BigInteger(small_numerator_ < 0 ? -small_numerator_ : small_numerator_);
+    denominator_ = BigInteger(small_denominator_);
+    small_ = false;
   }
+}
 
-  if (denominator_ % numerator_ == 0) {
-    denominator_ /= numerator_;
-    numerator_ = 1;
+// Moves a canonical value back to machine words once it fits
+void Rational::demote() const {
+  long long numerator, denominator;
+  if (small_ || !canonical_ || !numerator_.toLongLong(numerator) || !denominator_.toLongLong(denominator)) {
     return;
   }
 
-  BigInteger nod;
+  small_numerator_ = (sign_ == sign::NEGATIVE) ? -numerator : numerator;
+  small_denominator_ = denominator;
+  small_ = true;
+  numerator_ = BigInteger();
+  denominator_ = BigInteger();
+}
 
-  if (numerator_ < denominator_) {
-    nod = euclid(denominator_, numerator_);
-  } else {
-    nod = euclid(numerator_, denominator_);
+const Rational& Rational::asBig(const Rational& value, Rational& storage) {
+  if (!value.small_) {
+    return value;
   }
+  storage = value;
+  storage.promote();
+  return storage;
+}
 
-  if (nod != 1) {
-    denominator_ /= nod;
-    numerator_ /= nod;
+void Rational::setLazy(bool lazy) {
+  lazy_ = lazy;
+  if (!lazy_) {
+    canonicalize();
   }
 }
 
+bool Rational::isLazy() const { return lazy_; }
+
 Rational abs(const Rational& number) {
   if (number < 0) {
     return -number;
@@ -114,28 +267,49 @@ Rational abs(const Rational& number) {
 
 // Constructors
 
-Rational::Rational(int number): numerator_(abs(number)), denominator_(1), sign_((number == 0) ? (sign::ZERO) : (number < 0 ? sign::NEGATIVE : sign::POSITIVE)) {}
-
-Rational::Rational(const BigInteger& number): numerator_(abs(number)), denominator_(1), sign_((number == 0) ? (sign::ZERO) : (number < 0 ? sign::NEGATIVE : sign::POSITIVE)) {}
-
-// Comparison operators
+Rational::Rational(int number): small_numerator_(number), sign_((number == 0) ? (sign::ZERO) : (number < 0 ? sign::NEGATIVE : sign::POSITIVE)) {}
 
-bool operator==(const Rational& first, const Rational& second) { return first.numerator_ == second.numerator_ && first.denominator_ == second.denominator_ && first.sign_ == second.sign_; }
+Rational::Rational(const BigInteger& number): numerator_(abs(number)), denominator_(1), small_(false), sign_((number == 0) ? (sign::ZERO) : (number < 0 ? sign::NEGATIVE : sign::POSITIVE)) {
+  demote();
+}
 
-bool operator<(const Rational& first, const Rational& second) {
-  if (first.sign_ != second.sign_) {
-    return first.sign_ < second.sign_;
+template <std::floating_point Float>
+Rational::Rational(Float number): small_(false), sign_((number == 0) ? (sign::ZERO) : (number < 0 ? sign::NEGATIVE : sign::POSITIVE)) {
+  static_assert(std::numeric_limits<Float>::digits <= 64);
+  if (sign_ == sign::ZERO) {
+    assignSmall(0, 1);
+    return;
   }
 
-  if (first.sign_ == Rational::sign::ZERO) {
-    return false;
+  // |number| = bits * 2^exponent with odd bits, so a negative exponent already gives lowest terms
+  int exponent;
+  Float magnitude = std::fabs(number);
+  unsigned long long bits = static_cast<unsigned long long>(std::ldexp(std::frexp(magnitude, &exponent), 64));
+  exponent += std::countr_zero(bits) - 64;
+  if (exponent >= 0) {
+    numerator_ = BigInteger(magnitude);
+    denominator_ = 1;
+  } else {
+    numerator_ = BigInteger(std::ldexp(magnitude, -exponent));
+    denominator_ = power(BigInteger(2), static_cast<unsigned long long>(-exponent));
   }
+  demote();
+}
+
+// Comparison operators
 
-  if (first.sign_ == Rational::sign::POSITIVE) {
-    return first.numerator_ * second.denominator_ < first.denominator_ * second.numerator_;
+bool operator==(const Rational& first, const Rational& second) {
+  first.canonicalize();
+  second.canonicalize();
+  if (first.small_ || second.small_) {
+    return first.small_ == second.small_ && first.small_numerator_ == second.small_numerator_ &&
+           first.small_denominator_ == second.small_denominator_;
   }
+  return first.numerator_ == second.numerator_ && first.denominator_ == second.denominator_ && first.sign_ == second.sign_;
+}
 
-  return first.numerator_ * second.denominator_ > first.denominator_ * second.numerator_;
+bool operator<(const Rational& first, const Rational& second) {
+  return (first <=> second) < 0;
 }
 
 bool operator!=(const Rational& first, const Rational& second) {
@@ -154,75 +328,228 @@ bool operator<=(const Rational& first, const Rational& second) {
   return !operator<(second, first);
 }
 
-// Calculation operators
-
-Rational& Rational::operator+=(const Rational& other) {
-  if (other.sign_ == sign::ZERO) {
-    return *this;
+std::strong_ordering operator<=>(const Rational& first_value, const Rational& second_value) {
+  first_value.canonicalize();
+  second_value.canonicalize();
+  if (first_value.sign_ != second_value.sign_) {
+    return first_value.sign_ <=> second_value.sign_;
+  }
 
-  } else if (sign_ == other.sign_) {
-    numerator_ = numerator_ * other.denominator_ + denominator_ * other.numerator_;
-    denominator_ *= other.denominator_;
+  if (first_value.sign_ == Rational::sign::ZERO) {
+    return std::strong_ordering::equal;
+  }
 
-    reduction();
-    return *this;
+  if (first_value.small_ && second_value.small_) {
+    int64_t left, right;
+    if (!__builtin_mul_overflow(first_value.small_numerator_, second_value.small_denominator_, &left) &&
+        !__builtin_mul_overflow(second_value.small_numerator_, first_value.small_denominator_, &right)) {
+      return left <=> right;
+    }
   }
 
-  return *this -= -other;
+  Rational first_storage, second_storage;
+  const Rational& first = Rational::asBig(first_value, first_storage);
+  const Rational& second = Rational::asBig(second_value, second_storage);
+  std::strong_ordering result = Rational::compareMagnitudes(first.numerator_, first.denominator_, second.numerator_, second.denominator_);
+  return (first.sign_ == Rational::sign::NEGATIVE) ? 0 <=> result : result;
 }
 
-Rational& Rational::operator-=(const Rational& other) {
-  if (sign_ == sign::ZERO) {
-    *this = -other;
-    return *this;
+// Orders a / b against c / d through progressively more expensive tiers: the binary exponents of the
+// cross products a * d and c * b, their leading bits, the continued fraction terms and finally the
+// exact products
+std::strong_ordering Rational::compareMagnitudes(const BigInteger& first_numerator, const BigInteger& first_denominator,
+                                                 const BigInteger& second_numerator, const BigInteger& second_denominator) {
+  if (first_denominator == second_denominator) {
+    return first_numerator <=> second_numerator;
+  }
+  if (first_numerator == second_numerator) {
+    return second_denominator <=> first_denominator;
   }
 
-  if (sign_ == other.sign_) {
-    if (abs(*this) > abs(other)) {
-      numerator_ = numerator_ * other.denominator_ - denominator_ * other.numerator_;
-      denominator_ *= other.denominator_;
+  // Mantissa products lie in [0.25, 1), so an exponent gap of two decides on its own
+  long long exponents[4];
+  double mantissas[4] = {frexp(first_numerator, &exponents[0]), frexp(first_denominator, &exponents[1]),
+                         frexp(second_numerator, &exponents[2]), frexp(second_denominator, &exponents[3])};
+  long long gap = (exponents[0] + exponents[3]) - (exponents[2] + exponents[1]);
+  if (gap > 1) {
+    return std::strong_ordering::greater;
+  }
+  if (gap < -1) {
+    return std::strong_ordering::less;
+  }
 
-      reduction();
-      return *this;
+  // The mantissas carry a relative error below 2^-50 each
+  double ratio = std::ldexp((mantissas[0] * mantissas[3]) / (mantissas[2] * mantissas[1]), static_cast<int>(gap));
+  if (ratio > 1 + 1e-12) {
+    return std::strong_ordering::greater;
+  }
+  if (ratio < 1 - 1e-12) {
+    return std::strong_ordering::less;
+  }
+
+  if (exponents[0] - exponents[1] > 64) {
+    return first_numerator * second_denominator <=> second_numerator * first_denominator;
+  }
+
+  // a / b = q + r / b, equal integer parts leave r / b against r' / d, which is b / r against d / r'
+  // in reverse order
+  BigInteger a = first_numerator, b = first_denominator, c = second_numerator, d = second_denominator;
+  bool reversed = false;
+  for (int step = 0; step < CONTINUED_FRACTION_STEPS; ++step) {
+    auto [first_quotient, first_remainder] = divmod(a, b);
+    auto [second_quotient, second_remainder] = divmod(c, d);
+    std::strong_ordering result = first_quotient <=> second_quotient;
+    if (result == 0 && (first_remainder == 0 || second_remainder == 0)) {
+      result = first_remainder <=> second_remainder;
+    }
+    if (result != 0 || first_remainder == 0) {
+      return reversed ? 0 <=> result : result;
     }
 
-    if (abs(*this) == abs(other)) {
-      *this = 0;
-      return *this;
+    a = std::move(b);
+    b = std::move(first_remainder);
+    c = std::move(d);
+    d = std::move(second_remainder);
+    reversed = !reversed;
+  }
+
+  std::strong_ordering result = a * d <=> c * b;
+  return reversed ? 0 <=> result : result;
+}
+
+// Calculation operators
+
+// Henrici's addition: with d = gcd(b, d'), a/b + c/d' = t / (b/d * d'/g) for t = a * (d'/d) + c * (b/d)
+// and g = gcd(t, d), so the GCDs run on the denominators instead of the grown cross products
+Rational& Rational::add(const Rational& other_value, bool subtract) {
+  if (other_value.sign_ == sign::ZERO) {
+    return *this;
+  }
+  if (!lazy_) {
+    canonicalize();
+    other_value.canonicalize();
+  }
+  if (small_ && other_value.small_ && addSmall(other_value, subtract)) {
+    return *this;
+  }
+
+  Rational storage;
+  const Rational& other = asBig(other_value, storage);
+  promote();
+  BigInteger other_numerator = other.signedNumerator();
+  if (subtract) {
+    other_numerator = -std::move(other_numerator);
+  }
+
+  if (sign_ == sign::ZERO) {
+    assign(std::move(other_numerator), BigInteger(other.denominator_), other.canonical_);
+    if (!lazy_) {
+      canonicalize();
     }
+    return *this;
+  }
 
-    numerator_ = other.numerator_ * denominator_ - other.denominator_ * numerator_;
-    denominator_ *= other.denominator_;
-    sign_ = (sign_ == sign::POSITIVE) ? sign::NEGATIVE : sign::POSITIVE;
+  if (lazy_) {
+    BigInteger numerator = signedNumerator() * other.denominator_;
+    numerator.addmul(other_numerator, denominator_);
+    assign(std::move(numerator), denominator_ * other.denominator_, false);
+    return *this;
+  }
 
-    reduction();
+  BigInteger divider = gcd(denominator_, other.denominator_);
+  if (divider == 1) {
+    BigInteger numerator = signedNumerator() * other.denominator_;
+    numerator.addmul(other_numerator, denominator_);
+    assign(std::move(numerator), denominator_ * other.denominator_, true);
     return *this;
   }
-  return *this += -other;
+
+  BigInteger own_part = denominator_ / divider;
+  BigInteger numerator = signedNumerator() * (other.denominator_ / divider);
+  numerator.addmul(other_numerator, own_part);
+  BigInteger common = gcd(numerator, divider);
+  if (common != 1) {
+    numerator /= common;
+  }
+  assign(std::move(numerator), own_part * (other.denominator_ / common), true);
+  return *this;
 }
 
-Rational& Rational::operator*=(const Rational& other) {
-  int sign = static_cast<int>(sign_) * static_cast<int>(other.sign_);
+Rational& Rational::operator+=(const Rational& other) { return add(other, false); }
 
-  sign_ = (sign == 0) ? sign::ZERO : (sign > 0 ? sign::POSITIVE : sign::NEGATIVE);
-  numerator_ *= other.numerator_;
-  denominator_ *= other.denominator_;
+Rational& Rational::operator-=(const Rational& other) { return add(other, true); }
 
-  reduction();
+// Cross GCDs: a/b * c/d = (a/g1 * c/g2) / (b/g2 * d/g1) for g1 = gcd(a, d) and g2 = gcd(b, c)
+Rational& Rational::operator*=(const Rational& other_value) {
+  int sign = static_cast<int>(sign_) * static_cast<int>(other_value.sign_);
+  if (sign == 0) {
+    assignSmall(0, 1);
+    canonical_ = true;
+    return *this;
+  }
+  if (!lazy_) {
+    canonicalize();
+    other_value.canonicalize();
+  }
+  if (small_ && other_value.small_ && multiplySmall(other_value.small_numerator_, other_value.small_denominator_)) {
+    return *this;
+  }
+
+  Rational storage;
+  const Rational& other = asBig(other_value, storage);
+  promote();
+  if (lazy_) {
+    numerator_ *= other.numerator_;
+    denominator_ *= other.denominator_;
+    canonical_ = false;
+  } else {
+    BigInteger first_divider = gcd(numerator_, other.denominator_);
+    BigInteger second_divider = gcd(denominator_, other.numerator_);
+    BigInteger numerator = (numerator_ / first_divider) * (other.numerator_ / second_divider);
+    denominator_ = (denominator_ / second_divider) * (other.denominator_ / first_divider);
+    numerator_ = std::move(numerator);
+  }
+  sign_ = (sign > 0) ? sign::POSITIVE : sign::NEGATIVE;
+  demote();
   return *this;
 }
 
-Rational& Rational::operator/=(const Rational& other) {
-  if (*this == 0) {
+// Same cross GCDs with the other value inverted
+Rational& Rational::operator/=(const Rational& other_value) {
+  if (sign_ == sign::ZERO) {
     return *this;
   }
+  if (!lazy_) {
+    canonicalize();
+    other_value.canonicalize();
+  }
+  if (small_ && other_value.small_ && other_value.sign_ != sign::ZERO) {
+    int64_t numerator = other_value.small_numerator_;
+    if (multiplySmall((numerator < 0) ? -other_value.small_denominator_ : other_value.small_denominator_,
+                      (numerator < 0) ? -numerator : numerator)) {
+      return *this;
+    }
+  }
+
+  Rational storage;
+  const Rational& other = asBig(other_value, storage);
   int sign = static_cast<int>(sign_) * static_cast<int>(other.sign_);
+  promote();
 
+  if (lazy_) {
+    BigInteger numerator = numerator_ * other.denominator_;
+    denominator_ *= other.numerator_;
+    numerator_ = std::move(numerator);
+    canonical_ = false;
+  } else {
+    BigInteger first_divider = gcd(numerator_, other.numerator_);
+    BigInteger second_divider = gcd(denominator_, other.denominator_);
+    BigInteger numerator = (numerator_ / first_divider) * (other.denominator_ / second_divider);
+    denominator_ = (denominator_ / second_divider) * (other.numerator_ / first_divider);
+    numerator_ = std::move(numerator);
+  }
   sign_ = (sign == 0) ? sign::ZERO : (sign > 0 ? sign::POSITIVE : sign::NEGATIVE);
-  numerator_ *= other.denominator_;
-  denominator_ *= other.numerator_;
-
-  reduction();
+  demote();
   return *this;
 }
 
@@ -250,21 +577,76 @@ Rational operator/(const Rational& first, const Rational& second) {
   return result;
 }
 
-Rational Rational::operator-() const {
+Rational operator+(Rational&& first, const Rational& second) {
+  first += second;
+  return std::move(first);
+}
+
+Rational operator+(const Rational& first, Rational&& second) {
+  second += first;
+  return std::move(second);
+}
+
+Rational operator+(Rational&& first, Rational&& second) {
+  first += second;
+  return std::move(first);
+}
+
+Rational operator-(Rational&& first, const Rational& second) {
+  first -= second;
+  return std::move(first);
+}
+
+Rational operator*(Rational&& first, const Rational& second) {
+  first *= second;
+  return std::move(first);
+}
+
+Rational operator*(const Rational& first, Rational&& second) {
+  second *= first;
+  return std::move(second);
+}
+
+Rational operator*(Rational&& first, Rational&& second) {
+  first *= second;
+  return std::move(first);
+}
+
+Rational operator/(Rational&& first, const Rational& second) {
+  first /= second;
+  return std::move(first);
+}
+
+Rational Rational::operator-() const& {
   Rational result(*this);
-  result.sign_ = (sign_ == sign::ZERO) ? (sign::ZERO) : (sign_ == sign::POSITIVE ? sign::NEGATIVE : sign::POSITIVE);
-  return result;
+  return -std::move(result);
+}
+
+Rational Rational::operator-() && {
+  small_numerator_ = -small_numerator_;
+  sign_ = (sign_ == sign::ZERO) ? (sign::ZERO) : (sign_ == sign::POSITIVE ? sign::NEGATIVE : sign::POSITIVE);
+  return std::move(*this);
 }
 
 // String methods
 
 std::string Rational::toString() const {
+  canonicalize();
   std::string number;
 
   if (sign_ == sign::ZERO) {
     return "0";
   }
 
+  if (small_) {
+    number = std::to_string(small_numerator_);
+    if (small_denominator_ != 1) {
+      number.push_back('/');
+      number += std::to_string(small_denominator_);
+    }
+    return number;
+  }
+
   if (sign_ == sign::NEGATIVE) {
     number.push_back('-');
   }
@@ -279,46 +661,167 @@ std::string Rational::toString() const {
   return number;
 }
 
-std::string Rational::asDecimal(size_t precision) const {
-  std::string string;
-
-  if (sign_ == sign::ZERO) {
-    return "0";
+// Floating point conversion
+
+// Operands below 2^digits are exact in Float and a single IEEE division rounds correctly, the rest
+// goes through a scaled integer division
+template <class Float>
+Float Rational::toFloating() const {
+  Float magnitude;
+  if (small_) {
+    uint64_t numerator = (small_numerator_ < 0) ? -static_cast<uint64_t>(small_numerator_) : small_numerator_;
+    uint64_t denominator = small_denominator_;
+    if (std::bit_width(numerator) <= std::numeric_limits<Float>::digits && std::bit_width(denominator) <= std::numeric_limits<Float>::digits) {
+      magnitude = static_cast<Float>(numerator) / static_cast<Float>(denominator);
+    } else {
+      magnitude = BigInteger::quotient_to_floating<Float>(BigInteger(static_cast<long long>(numerator)), BigInteger(static_cast<long long>(denominator)));
+    }
+  } else {
+    magnitude = BigInteger::quotient_to_floating<Float>(numerator_, denominator_);
   }
+  return (sign_ == sign::NEGATIVE) ? -magnitude : magnitude;
+}
 
-  if (sign_ == sign::NEGATIVE) {
-    string.push_back('-');
+double Rational::toDouble() const { return toFloating<double>(); }
+
+long double Rational::toLongDouble() const { return toFloating<long double>(); }
+
+Rational::operator double() const { return toDouble(); }
+
+// CLASS DECIMALDIGITS
+
+// Decimal expansion of a Rational: the integer part is available at once, the fractional digits are
+// generated on demand, so an expansion costs no more than the digits actually taken from it
+class DecimalDigits {
+ public:
+  explicit DecimalDigits(const Rational& number);
+
+  bool negative() const;
+  const BigInteger& integerPart() const;
+  // True once every further digit is zero
+  bool finished() const;
+
+  // Writes the next count fractional digits, generated in chunks of 9 by one division each
+  template <class OutputIt>
+  OutputIt next(OutputIt out, size_t count);
+  // Writes the next count fractional digits from a single division of remainder * 10^count
+  template <class OutputIt>
+  OutputIt nextBulk(OutputIt out, size_t count);
+
+ private:
+  static const long long CHUNK_BASE = 1'000'000'000;
+  static const size_t CHUNK_SIZE = 9;
+
+  BigInteger integer_part_;
+  BigInteger remainder_;
+  BigInteger denominator_;
+  bool negative_;
+
+  // Digits of the last chunk not yet written
+  char pending_[CHUNK_SIZE];
+  size_t pending_begin_ = CHUNK_SIZE;
+
+  long long nextChunk();
+  template <class OutputIt>
+  OutputIt flushPending(OutputIt out, size_t& count);
+};
+
+DecimalDigits::DecimalDigits(const Rational& number): negative_(number.sign_ == Rational::sign::NEGATIVE) {
+  number.canonicalize();
+  if (number.small_) {
+    long long numerator = number.small_numerator_;
+    std::tie(integer_part_, remainder_) = divmod(BigInteger(negative_ ? -numerator : numerator), BigInteger(number.small_denominator_));
+    denominator_ = number.small_denominator_;
+  } else {
+    std::tie(integer_part_, remainder_) = divmod(number.numerator_, number.denominator_);
+    denominator_ = number.denominator_;
   }
+}
+
+bool DecimalDigits::negative() const { return negative_; }
 
-  if (denominator_ == 1) {
-    string += numerator_.toString();
-    return string;
+const BigInteger& DecimalDigits::integerPart() const { return integer_part_; }
+
+bool DecimalDigits::finished() const { return pending_begin_ == CHUNK_SIZE && remainder_ == 0; }
+
+long long DecimalDigits::nextChunk() {
+  if (remainder_ == 0) {
+    return 0;
   }
 
-  BigInteger pow = power(10, precision);
-  BigInteger num = numerator_ * pow;
-  num /= denominator_;
-  string += (num / pow).toString();
+  remainder_ *= CHUNK_BASE;
+  auto [chunk, remainder] = divmod(remainder_, denominator_);
+  remainder_ = std::move(remainder);
+  long long value = 0;
+  chunk.toLongLong(value);
+  return value;
+}
 
-  if (precision > 0) {
-    string.push_back('.');
-    BigInteger degree = 10;
+template <class OutputIt>
+OutputIt DecimalDigits::flushPending(OutputIt out, size_t& count) {
+  size_t taken = std::min(count, CHUNK_SIZE - pending_begin_);
+  out = std::copy_n(pending_ + pending_begin_, taken, out);
+  pending_begin_ += taken;
+  count -= taken;
+  return out;
+}
 
-    while (num * degree / pow == 0) {
-      string += '0';
-      degree *= 10;
+template <class OutputIt>
+OutputIt DecimalDigits::next(OutputIt out, size_t count) {
+  out = flushPending(out, count);
+  while (count > 0) {
+    long long chunk = nextChunk();
+    for (size_t i = CHUNK_SIZE; i-- > 0; chunk /= 10) {
+      pending_[i] = static_cast<char>('0' + chunk % 10);
     }
+    pending_begin_ = 0;
+    out = flushPending(out, count);
+  }
+  return out;
+}
+
+template <class OutputIt>
+OutputIt DecimalDigits::nextBulk(OutputIt out, size_t count) {
+  out = flushPending(out, count);
+  if (count == 0) {
+    return out;
+  }
+  if (remainder_ == 0) {
+    return std::fill_n(out, count, '0');
+  }
+
+  auto [digits, remainder] = divmod(remainder_ * power(BigInteger(10), static_cast<unsigned long long>(count)), denominator_);
+  remainder_ = std::move(remainder);
+  std::string text = digits.toString();
+  out = std::fill_n(out, count - text.size(), '0');
+  return std::copy(text.begin(), text.end(), out);
+}
 
-    string += (num % pow).toString();
+// Decimal expansion
 
+// Truncated to precision fractional digits, trailing zeros are dropped
+std::string Rational::asDecimal(size_t precision) const {
+  DecimalDigits digits(*this);
+  std::string string = digits.integerPart().toString();
+
+  if (precision > 0 && !digits.finished()) {
+    string.push_back('.');
+    size_t denominator_size = small_ ? 2 : denominator_.digits_.size();
+    if (precision >= DECIMAL_STREAMING_RATIO * denominator_size) {
+      digits.next(std::back_inserter(string), precision);
+    } else {
+      digits.nextBulk(std::back_inserter(string), precision);
+    }
     while (string.back() == '0') {
       string.pop_back();
     }
+    if (string.back() == '.') {
+      string.pop_back();
+    }
   }
 
+  if (digits.negative() && string != "0") {
+    string.insert(string.begin(), '-');
+  }
   return string;
 }
-
-// Operator double()
-
-Rational::operator double() const { return stod(asDecimal()); }
@@ -0,0 +1,35 @@
+#include <cassert>
+#include <random>
+#include <utility>
+#include "../biginteger.h"
+#include "reference.h"
+
+// BigDivisor for each of its strategies: single limb, normalized Algorithm D, Burnikel-Ziegler and
+// Barrett reduction (from 1000 limbs), reused across many dividends
+int main() {
+  std::mt19937_64 generator(5);
+  const size_t divider_sizes[] = {1, 50, 200, 1000, 1100};
+
+  for (size_t divider_size : divider_sizes) {
+    reference::Limbs b = reference::random(generator, divider_size);
+    BigInteger divider(reference::decimal(b));
+    BigDivisor divisor(divider);
+    BigDivisor negative_divisor(-divider);
+    assert(divisor.divider() == divider);
+
+    const size_t dividend_sizes[] = {divider_size / 2 + 1, divider_size, divider_size + 3, 2 * divider_size, 2 * divider_size + 7, 3 * divider_size};
+    for (size_t dividend_size : dividend_sizes) {
+      reference::Limbs a = reference::random(generator, dividend_size);
+      BigInteger dividend(reference::decimal(a));
+
+      auto [quotient, remainder] = divisor.divmod(dividend);
+      assert(reference::is_division(a, b, reference::parse(quotient.toString()), reference::parse(remainder.toString())));
+      assert(divisor.div(dividend) == quotient);
+      assert(divisor.mod(dividend) == remainder);
+      assert(divisor.div(-dividend) == -quotient);
+      assert(divisor.mod(-dividend) == -remainder);
+      assert(negative_divisor.div(dividend) == -quotient);
+      assert(negative_divisor.mod(dividend) == remainder);
+    }
+  }
+}
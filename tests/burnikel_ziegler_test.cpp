@@ -0,0 +1,36 @@
+#include <cassert>
+#include <random>
+#include <utility>
+#include "../biginteger.h"
+#include "reference.h"
+
+// Burnikel-Ziegler recursion (dividers from 150 limbs) against the reference, with quotients both
+// shorter and longer than the divider
+int main() {
+  std::mt19937_64 generator(4);
+  const std::pair<size_t, size_t> sizes[] = {{300, 150}, {301, 160}, {450, 151}, {700, 200}, {1000, 500}, {1200, 300}};
+
+  for (auto [dividend_size, divider_size] : sizes) {
+    for (int round = 0; round < 3; ++round) {
+      reference::Limbs a = reference::random(generator, dividend_size);
+      reference::Limbs b = reference::random(generator, divider_size);
+      BigInteger dividend(reference::decimal(a));
+      BigInteger divider(reference::decimal(b));
+
+      auto [quotient, remainder] = divmod(dividend, divider);
+      assert(reference::is_division(a, b, reference::parse(quotient.toString()), reference::parse(remainder.toString())));
+      assert(dividend / divider == quotient);
+      assert(dividend % divider == remainder);
+      assert(-dividend / divider == -quotient);
+      assert(-dividend % divider == -remainder);
+    }
+  }
+
+  // An exact quotient leaves no remainder
+  reference::Limbs b = reference::random(generator, 170);
+  reference::Limbs q = reference::random(generator, 230);
+  BigInteger divider(reference::decimal(b));
+  BigInteger product(reference::decimal(reference::multiply(q, b)));
+  assert((product / divider).toString() == reference::decimal(q));
+  assert(product % divider == 0);
+}
@@ -0,0 +1,56 @@
+#include <cassert>
+#include <charconv>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include "../biginteger.h"
+#include "reference.h"
+
+bool throws_invalid_argument(const std::string& text) {
+  try {
+    BigInteger value(text);
+  } catch (const std::invalid_argument&) {
+    return true;
+  }
+  return false;
+}
+
+// Decimal conversion chunk by chunk (up to 60 limbs) and by divide and conquer above that, against
+// the reference conversion
+int main() {
+  std::mt19937_64 generator(9);
+  const size_t sizes[] = {1, 2, 30, 60, 61, 200, 1000, 3000};
+  for (size_t size : sizes) {
+    reference::Limbs a = reference::random(generator, size);
+    std::string expected = reference::decimal(a);
+    BigInteger value(expected);
+    assert(reference::compare(reference::parse(value.toString()), a) == 0);
+    assert(value.toString() == expected);
+    assert((-value).toString() == "-" + expected);
+
+    std::string buffer(value.stringLengthBound(), '\0');
+    std::to_chars_result written = to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+    assert(written.ec == std::errc() && std::string(buffer.data(), written.ptr) == expected);
+    std::to_chars_result short_buffer = to_chars(buffer.data(), buffer.data() + expected.size() - 1, value);
+    assert(short_buffer.ec == std::errc::value_too_large);
+
+    BigInteger parsed;
+    std::from_chars_result read = from_chars(expected.data(), expected.data() + expected.size(), parsed);
+    assert(read.ec == std::errc() && read.ptr == expected.data() + expected.size() && parsed == value);
+
+    std::stringstream stream;
+    stream << value;
+    BigInteger streamed;
+    stream >> streamed;
+    assert(streamed == value);
+  }
+
+  // Zero-padded chunks inside the number
+  assert(BigInteger("1000000000000000000000000000001").toString() == "1000000000000000000000000000001");
+  assert(BigInteger("-0").toString() == "0");
+
+  assert(throws_invalid_argument("abc"));
+  assert(throws_invalid_argument(""));
+  assert(throws_invalid_argument("12x"));
+  assert(throws_invalid_argument("-"));
+}
@@ -0,0 +1,120 @@
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <random>
+#include <thread>
+#include <vector>
+#include "../biginteger.h"
+#include "reference.h"
+
+// Counts the blocks taken from the global heap
+std::atomic<size_t> heap_allocations = 0;
+
+void* operator new(size_t bytes) {
+  ++heap_allocations;
+  if (void* block = std::malloc(bytes == 0 ? 1 : bytes)) {
+    return block;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* block) noexcept {
+  std::free(block);
+}
+
+void operator delete(void* block, size_t) noexcept {
+  std::free(block);
+}
+
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  size_t outstanding = 0;
+
+ private:
+  void* do_allocate(size_t bytes, size_t alignment) override {
+    ++outstanding;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(void* pointer, size_t bytes, size_t alignment) override {
+    --outstanding;
+    std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+  }
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+// Copy-on-write limb storage: copies share heap blocks until one of them is written, reads never
+// unshare, copies may be read from several threads, and blocks from scoped resources are copied
+int main() {
+  std::mt19937_64 generator(25);
+  reference::Limbs limbs = reference::random(generator, 20);
+  const std::string decimal = reference::decimal(limbs);
+  BigInteger a(decimal);
+  BigInteger c(reference::decimal(reference::random(generator, 20)));
+
+  // Copies take no memory, and writes to one copy leave the other one alone
+  size_t before = heap_allocations;
+  BigInteger b = a;
+  BigInteger d = b;
+  assert(heap_allocations == before && b == a && d == a);
+  b += 1;
+  assert(a.toString() == decimal && b == a + 1);
+  d /= 3;
+  a -= 1;
+  assert(b.toString() == reference::decimal(reference::add(limbs, {1})) && a + 2 == b && d * 3 + BigInteger(decimal) % 3 == BigInteger(decimal));
+
+  // Multiplying a shared value only allocates its product
+  BigInteger e = c;
+  before = heap_allocations;
+  e *= a;
+  assert(heap_allocations == before + 1);
+  BigInteger f = c;
+  before = heap_allocations;
+  f *= f;
+  assert(heap_allocations == before + 1);
+  assert(e.toString() == reference::decimal(reference::multiply(reference::parse(c.toString()), reference::parse(a.toString()))));
+  assert(f == square(c) && c == BigInteger(c.toString()));
+
+  // Read-only copies handed to several threads, each writing only to its own copy
+  const BigInteger shared(reference::decimal(reference::random(generator, 300)));
+  const std::string shared_decimal = shared.toString();
+  std::vector<std::thread> threads;
+  std::vector<char> correct(4);
+  for (size_t i = 0; i < correct.size(); ++i) {
+    threads.emplace_back([&, i] {
+      bool ok = true;
+      for (int round = 0; round < 200; ++round) {
+        BigInteger copy = shared;
+        BigInteger product = copy * copy;
+        copy += static_cast<long long>(i + 1);
+        ok = ok && copy - shared == static_cast<long long>(i + 1) && product / shared == shared;
+      }
+      correct[i] = ok;
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  assert(correct == std::vector<char>(correct.size(), true));
+  assert(shared.toString() == shared_decimal);
+
+  // A copy of a value from a scoped resource gets a heap block of its own
+  CountingResource resource;
+  {
+    BigInteger copy;
+    {
+      std::unique_ptr<BigInteger> scoped;
+      {
+        MemoryScope scope(&resource);
+        scoped = std::make_unique<BigInteger>(a * c);
+      }
+      size_t outstanding = resource.outstanding;
+      before = heap_allocations;
+      copy = *scoped;
+      assert(heap_allocations == before + 1 && resource.outstanding == outstanding);
+    }
+    assert(resource.outstanding == 0);
+    assert(copy == a * c);
+  }
+}
@@ -0,0 +1,44 @@
+#include <cassert>
+#include <random>
+#include <utility>
+#include "../biginteger.h"
+#include "reference.h"
+
+// Algorithm D (dividers of 2 to 149 limbs) and the single-limb path, checked against the reference
+// through dividend == quotient * divider + remainder, with truncating signs
+void check(const reference::Limbs& a, const reference::Limbs& b) {
+  BigInteger dividend(reference::decimal(a));
+  BigInteger divider(reference::decimal(b));
+  BigInteger quotient = dividend / divider;
+  BigInteger remainder = dividend % divider;
+  assert(reference::is_division(a, b, reference::parse(quotient.toString()), reference::parse(remainder.toString())));
+
+  assert(-dividend / divider == -quotient);
+  assert(-dividend % divider == -remainder);
+  assert(dividend / -divider == -quotient);
+  assert(dividend % -divider == remainder);
+}
+
+int main() {
+  std::mt19937_64 generator(3);
+  const std::pair<size_t, size_t> sizes[] = {{1, 1}, {5, 1}, {2, 2}, {3, 2}, {10, 4}, {60, 30}, {200, 100}, {298, 149}, {149, 149}};
+
+  for (auto [dividend_size, divider_size] : sizes) {
+    for (int round = 0; round < 20; ++round) {
+      check(reference::random(generator, dividend_size), reference::random(generator, divider_size));
+    }
+  }
+
+  // Top limb 2^31 with zero limbs below makes the quotient estimate overshoot and forces the add-back
+  reference::Limbs divider(3, 0);
+  divider[2] = 0x8000'0000;
+  reference::Limbs dividend(6, 0xFFFF'FFFF);
+  dividend[2] = 0;
+  check(dividend, divider);
+  check(reference::Limbs(7, 0xFFFF'FFFF), reference::Limbs{1, 0, 0x8000'0000});
+
+  // A smaller dividend leaves it as the remainder
+  BigInteger small("12345678901234567890");
+  assert(small / BigInteger("123456789012345678901234567890") == 0);
+  assert(small % BigInteger("-123456789012345678901234567890") == small);
+}
@@ -0,0 +1,74 @@
+#include <cassert>
+#include <random>
+#include <stdexcept>
+#include "../biginteger.h"
+#include "reference.h"
+
+template <size_t Bits>
+BigInteger wrap(const BigInteger& value) {
+  static const BigInteger modulus = power(BigInteger(2), Bits);
+  BigInteger magnitude = abs(value) % modulus;
+  return value < 0 ? -magnitude : magnitude;
+}
+
+template <size_t Bits>
+void check(std::mt19937_64& generator) {
+  using Fixed = FixedBigInteger<Bits>;
+  for (int round = 0; round < 300; ++round) {
+    BigInteger a(reference::decimal(reference::random(generator, 1 + generator() % (Bits / 32))));
+    BigInteger b(reference::decimal(reference::random(generator, 1 + generator() % (Bits / 32))));
+    a = generator() % 2 ? -a : a;
+    b = generator() % 2 ? -b : b;
+    Fixed first(a), second(b);
+    assert(BigInteger(first) == a && first.toString() == a.toString() && Fixed(a.toString()) == first);
+
+    assert(BigInteger(first + second) == wrap<Bits>(a + b));
+    assert(BigInteger(first - second) == wrap<Bits>(a - b));
+    assert(BigInteger(first * second) == wrap<Bits>(a * b));
+    assert(BigInteger(first / second) == a / b);
+    assert(BigInteger(first % second) == a % b);
+    assert((first < second) == (a < b) && (first == second) == (a == b));
+    // Narrowing keeps the magnitude modulo 2^Bits
+    assert(BigInteger(Fixed(a * b)) == wrap<Bits>(a * b));
+  }
+}
+
+constexpr FixedBigInteger<128> factorial(int n) {
+  FixedBigInteger<128> result = 1;
+  for (int i = 2; i <= n; ++i) {
+    result *= i;
+  }
+  return result;
+}
+
+// FixedBigInteger against BigInteger reduced modulo 2^Bits, in constant expressions and with a zero divider
+int main() {
+  std::mt19937_64 generator(23);
+  check<32>(generator);
+  check<64>(generator);
+  check<256>(generator);
+  check<1024>(generator);
+
+  static_assert(factorial(30) == FixedBigInteger<128>("265252859812191058636308480000000"));
+  static_assert(factorial(30) / factorial(28) == 870 && factorial(30) % 7 == 0);
+  static_assert(FixedBigInteger<64>("18446744073709551615") + 1 == 0);
+  static_assert(FixedBigInteger<64>(-7) / 2 == -3 && FixedBigInteger<64>(-7) % 2 == -1);
+  static_assert((FixedBigInteger<128>(1) <=> FixedBigInteger<128>(-1)) > 0);
+
+  for (FixedBigInteger<256> dividend : {FixedBigInteger<256>(0), FixedBigInteger<256>(5), FixedBigInteger<256>(-factorial(30))}) {
+    bool thrown = false;
+    try {
+      dividend /= 0;
+    } catch (const std::domain_error&) {
+      thrown = true;
+    }
+    assert(thrown);
+    thrown = false;
+    try {
+      dividend % FixedBigInteger<256>();
+    } catch (const std::domain_error&) {
+      thrown = true;
+    }
+    assert(thrown);
+  }
+}
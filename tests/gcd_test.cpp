@@ -0,0 +1,47 @@
+#include <cassert>
+#include <random>
+#include <utility>
+#include "../biginteger.h"
+#include "reference.h"
+
+BigInteger euclid(BigInteger a, BigInteger b) {
+  a = abs(a);
+  b = abs(b);
+  while (b != 0) {
+    a %= b;
+    std::swap(a, b);
+  }
+  return a;
+}
+
+// Binary, Lehmer and half-GCD (from 120 limbs) reduction against Euclid's algorithm on operands
+// with a known common factor
+int main() {
+  std::mt19937_64 generator(13);
+  const std::pair<size_t, size_t> sizes[] = {{1, 1}, {2, 1}, {10, 7}, {60, 60}, {119, 100}, {120, 120}, {200, 150}, {500, 300}};
+  const size_t factor_sizes[] = {1, 5, 40};
+
+  for (auto [first_size, second_size] : sizes) {
+    for (size_t factor_size : factor_sizes) {
+      BigInteger factor(reference::decimal(reference::random(generator, factor_size)));
+      BigInteger first = factor * BigInteger(reference::decimal(reference::random(generator, first_size)));
+      BigInteger second = -factor * BigInteger(reference::decimal(reference::random(generator, second_size)));
+      BigInteger expected = euclid(first, second);
+      assert(expected % factor == 0);
+
+      assert(gcd(first, second) == expected);
+      assert(gcd(second, first) == expected);
+      assert(lcm(first, second) == abs(first / expected * second));
+
+      BigInteger x, y;
+      assert(gcdext(first, second, x, y) == expected);
+      assert(first * x + second * y == expected);
+      assert(abs(x) * 2 * expected <= abs(second));
+    }
+  }
+
+  BigInteger value("123456789012345678901234567890");
+  assert(gcd(value, 0) == value);
+  assert(gcd(0, -value) == value);
+  assert(gcd(0, 0) == 0);
+}
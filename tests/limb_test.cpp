@@ -0,0 +1,37 @@
+#include <cassert>
+#include <climits>
+#include <random>
+#include "../biginteger.h"
+#include "reference.h"
+
+// Base 2^32 limbs: carries and borrows across limb boundaries, signs and the long long boundary
+int main() {
+  std::mt19937_64 generator(8);
+
+  for (int round = 0; round < 2000; ++round) {
+    reference::Limbs a = reference::random(generator, 1 + generator() % 12);
+    reference::Limbs b = reference::random(generator, 1 + generator() % 12);
+    BigInteger first(reference::decimal(a));
+    BigInteger second(reference::decimal(b));
+    assert(first.toString() == reference::decimal(a));
+
+    assert((first + second).toString() == reference::decimal(reference::add(a, b)));
+    assert((first * second).toString() == reference::decimal(reference::multiply(a, b)));
+    if (reference::compare(a, b) >= 0) {
+      assert((first - second).toString() == reference::decimal(reference::subtract(a, b)));
+      assert((second - first).toString() == "-" + reference::decimal(reference::subtract(a, b)) || a == b);
+    }
+    assert((first < second) == (reference::compare(a, b) < 0));
+    assert((-first + second) == second - first);
+  }
+
+  BigInteger limb_max(4294967295LL);
+  assert((limb_max + 1).toString() == "4294967296");
+  assert((limb_max * limb_max).toString() == "18446744065119617025");
+  assert((BigInteger("18446744073709551616") - 1).toString() == "18446744073709551615");
+
+  long long result = 0;
+  assert(BigInteger(LLONG_MIN).toString() == "-9223372036854775808");
+  assert(BigInteger(LLONG_MAX).toLongLong(result) && result == LLONG_MAX);
+  assert(!BigInteger("9223372036854775808").toLongLong(result));
+}
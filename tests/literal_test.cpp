@@ -0,0 +1,20 @@
+#include <cassert>
+#include "../biginteger.h"
+
+int main() {
+  // Hexadecimal and binary digits carry more bits than decimal ones
+  BigInteger hex = 0xFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF_bi;
+  assert(hex == BigInteger("2582249878086908589655919172003011874329705792829223512830659356540647622016841194629645353280137831435903171972747493375"));
+  BigInteger binary = 0b101010101010101010101010101010101010101010101010101010101010101010101010101010101010101010101010101010101010101010101010101010101010101010101010101010101010101011101_bi;
+  assert(binary == BigInteger("31178701596392595588345276431280704419326560916829"));
+  BigInteger octal = 0777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777_bi;
+  assert(octal == BigInteger("1897137590064188545819787018382342682267975428761855001222473056385648716020711423"));
+
+  constexpr auto fixed_hex = 0xFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF_fbi;
+  assert(BigInteger(fixed_hex) == hex);
+  constexpr auto fixed_binary = 0b101010101010101010101010101010101010101010101010101010101010101010101010101010101010101010101010101010101010101010101010101010101010101010101010101010101010101011101_fbi;
+  assert(BigInteger(fixed_binary) == binary);
+
+  assert(0xFFFF'FFFF'FFFF'FFFF'FFFF_bi == BigInteger("1208925819614629174706175"));
+  assert(18'446'744'073'709'551'616_bi == BigInteger("18446744073709551616"));
+}
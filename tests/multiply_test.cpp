@@ -0,0 +1,32 @@
+#include <cassert>
+#include <random>
+#include <utility>
+#include "../biginteger.h"
+#include "reference.h"
+
+// Schoolbook, Karatsuba (from 40 limbs) and Toom-3 (from 160 limbs) against the reference product,
+// balanced and unbalanced, with all sign combinations
+int main() {
+  std::mt19937_64 generator(1);
+  const std::pair<size_t, size_t> sizes[] = {
+      {5, 3}, {39, 39}, {40, 40}, {45, 80}, {100, 41}, {159, 159}, {160, 160}, {170, 300}, {400, 161}, {700, 200}};
+
+  for (auto [first_size, second_size] : sizes) {
+    for (int round = 0; round < 3; ++round) {
+      reference::Limbs a = reference::random(generator, first_size);
+      reference::Limbs b = reference::random(generator, second_size);
+      std::string expected = reference::decimal(reference::multiply(a, b));
+      BigInteger first(reference::decimal(a));
+      BigInteger second(reference::decimal(b));
+
+      assert((first * second).toString() == expected);
+      assert((second * first).toString() == expected);
+      assert((-first * second).toString() == "-" + expected);
+      assert((-first * -second).toString() == expected);
+
+      BigInteger product = first;
+      product *= second;
+      assert(product.toString() == expected);
+    }
+  }
+}
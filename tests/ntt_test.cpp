@@ -0,0 +1,27 @@
+#include <cassert>
+#include <random>
+#include <utility>
+#include "../biginteger.h"
+#include "reference.h"
+
+// NTT multiplication (shorter operand from 1000 limbs) against the reference product, including
+// the single-transform path for equal operands
+int main() {
+  std::mt19937_64 generator(2);
+  const std::pair<size_t, size_t> sizes[] = {{999, 999}, {1000, 1000}, {1500, 1001}, {2100, 1300}};
+
+  for (auto [first_size, second_size] : sizes) {
+    reference::Limbs a = reference::random(generator, first_size);
+    reference::Limbs b = reference::random(generator, second_size);
+    BigInteger first(reference::decimal(a));
+    BigInteger second(reference::decimal(b));
+
+    assert((first * second).toString() == reference::decimal(reference::multiply(a, b)));
+    assert((first * first).toString() == reference::decimal(reference::multiply(a, a)));
+  }
+
+  // All-ones limbs give the largest convolution coefficients
+  reference::Limbs ones(1200, 0xFFFF'FFFF);
+  BigInteger value(reference::decimal(ones));
+  assert((value * value).toString() == reference::decimal(reference::multiply(ones, ones)));
+}
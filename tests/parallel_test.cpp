@@ -0,0 +1,72 @@
+#include <cassert>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../biginteger.h"
+#include "reference.h"
+
+struct Results {
+  std::vector<BigInteger> products, squares, quotients, remainders, parsed;
+  std::vector<std::string> strings;
+};
+
+Results compute(const std::vector<BigInteger>& values, const std::vector<std::string>& decimals) {
+  Results results;
+  for (size_t i = 0; i + 1 < values.size(); i += 2) {
+    results.products.push_back(values[i] * values[i + 1]);
+    results.squares.push_back(square(values[i]));
+    BigInteger dividend = values[i] * values[i] + values[i + 1];
+    results.quotients.push_back(dividend / values[i + 1]);
+    results.remainders.push_back(dividend % values[i + 1]);
+    results.strings.push_back(dividend.toString());
+  }
+  for (const std::string& decimal : decimals) {
+    results.parsed.push_back(BigInteger(decimal));
+  }
+  return results;
+}
+
+bool operator==(const Results& first, const Results& second) {
+  return first.products == second.products && first.squares == second.squares && first.quotients == second.quotients &&
+         first.remainders == second.remainders && first.parsed == second.parsed && first.strings == second.strings;
+}
+
+// Parallel mode against single-threaded results: multiplication across Karatsuba, Toom-3 and NTT sizes,
+// squaring, Burnikel-Ziegler division and both radix conversions, also with several callers at once
+int main() {
+  std::mt19937_64 generator(21);
+  std::vector<BigInteger> values;
+  std::vector<std::string> decimals;
+  for (size_t size : {50, 170, 171, 400, 1100, 3000}) {
+    for (int round = 0; round < 2; ++round) {
+      reference::Limbs limbs = reference::random(generator, size);
+      values.emplace_back(reference::decimal(limbs));
+      decimals.push_back(reference::decimal(limbs));
+    }
+  }
+
+  BigInteger::setThreads(1);
+  Results sequential = compute(values, decimals);
+  for (size_t i = 0; i < 4; ++i) {
+    assert(sequential.products[i].toString() ==
+           reference::decimal(reference::multiply(reference::parse(decimals[2 * i]), reference::parse(decimals[2 * i + 1]))));
+  }
+
+  BigInteger::setThreads(4);
+  BigInteger::setParallelThreshold(40);
+  assert(compute(values, decimals) == sequential);
+
+  std::vector<std::thread> callers;
+  std::vector<char> agree(3);
+  for (size_t i = 0; i < agree.size(); ++i) {
+    callers.emplace_back([&, i] { agree[i] = compute(values, decimals) == sequential; });
+  }
+  for (std::thread& caller : callers) {
+    caller.join();
+  }
+  assert(agree == std::vector<char>(agree.size(), true));
+
+  BigInteger::setThreads(1);
+  assert(compute(values, decimals) == sequential);
+}
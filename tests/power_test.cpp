@@ -0,0 +1,48 @@
+#include <cassert>
+#include <random>
+#include <stdexcept>
+#include "../biginteger.h"
+#include "reference.h"
+
+template <class Exponent>
+bool throws_domain_error(const BigInteger& value, Exponent pow) {
+  try {
+    power(value, pow);
+  } catch (const std::domain_error&) {
+    return true;
+  }
+  return false;
+}
+
+// Squaring kernels on both sides of the Karatsuba (40), Toom-3 (160) and NTT (1000 limbs) thresholds,
+// and power() against repeated reference multiplication
+int main() {
+  std::mt19937_64 generator(7);
+  const size_t sizes[] = {1, 10, 39, 40, 45, 159, 160, 170, 999, 1000, 1100};
+  for (size_t size : sizes) {
+    reference::Limbs a = reference::random(generator, size);
+    BigInteger value(reference::decimal(a));
+    std::string expected = reference::decimal(reference::multiply(a, a));
+    assert(square(value).toString() == expected);
+    assert(square(-value).toString() == expected);
+  }
+
+  const size_t base_sizes[] = {1, 3, 20};
+  for (size_t size : base_sizes) {
+    reference::Limbs a = reference::random(generator, size);
+    BigInteger value(reference::decimal(a));
+    reference::Limbs expected{1};
+    for (int pow = 0; pow <= 37; ++pow) {
+      assert(power(value, pow).toString() == reference::decimal(expected));
+      assert(power(value, static_cast<unsigned long long>(pow)).toString() == reference::decimal(expected));
+      assert(power(value, BigInteger(pow)).toString() == reference::decimal(expected));
+      assert(power(-value, pow) == ((pow % 2 == 0) ? power(value, pow) : -power(value, pow)));
+      expected = reference::multiply(expected, a);
+    }
+  }
+
+  assert(throws_domain_error(BigInteger(2), -1));
+  assert(throws_domain_error(BigInteger(2), -1LL));
+  assert(throws_domain_error(BigInteger(2), BigInteger(-1)));
+  assert(power(BigInteger(0), 0) == 1);
+}
@@ -0,0 +1,70 @@
+#include <cassert>
+#include <random>
+#include <stdexcept>
+#include "../biginteger.h"
+#include "reference.h"
+
+// Right-to-left binary exponentiation with plain multiplication and %
+BigInteger naive_powmod(BigInteger base, BigInteger pow, const BigInteger& modulus) {
+  BigInteger result = 1;
+  base %= modulus;
+  while (pow != 0) {
+    if (pow % 2 == 1) {
+      result = result * base % modulus;
+    }
+    base = base * base % modulus;
+    pow /= 2;
+  }
+  return result;
+}
+
+int main() {
+  // Montgomery multiplication for odd moduli up to 400 limbs, BigDivisor reduction for even and
+  // longer ones, both with sliding windows over exponents of several lengths
+  std::mt19937_64 generator(6);
+  const size_t modulus_sizes[] = {1, 2, 10, 100, 400, 450};
+  for (size_t size : modulus_sizes) {
+    for (int parity = 0; parity < 2; ++parity) {
+      reference::Limbs m = reference::random(generator, size);
+      m[0] = (m[0] & ~1u) | static_cast<uint32_t>(parity);
+      m.back() |= 2;
+      BigInteger modulus(reference::decimal(m));
+      BigInteger base(reference::decimal(reference::random(generator, size + 1)));
+      const size_t exponent_sizes[] = {1, 3};
+      for (size_t exponent_size : exponent_sizes) {
+        BigInteger pow(reference::decimal(reference::random(generator, exponent_size)));
+        BigInteger expected = naive_powmod(base, pow, modulus);
+        assert(powmod(base, pow, modulus) == expected);
+        assert(powmod(base, pow, -modulus) == expected);
+      }
+    }
+  }
+
+  BigInteger modulus("170141183460469231731687303715884105727");
+  BigInteger value("123456789012345678901234567890");
+
+  // Negative exponents raise the modular inverse
+  BigInteger inverse = powmod(value, -1, modulus);
+  assert(value * inverse % modulus == 1);
+  assert(powmod(value, -5, modulus) == powmod(inverse, 5, modulus));
+  assert(powmod(-value, -3, modulus) == powmod(modulus - value % modulus, -3, modulus));
+  assert(powmod(3, -2, 1000) == 889);
+  assert(powmod(6, -1, 1) == 0);
+  assert(powmod(6, 0, 7) == 1);
+
+  bool thrown = false;
+  try {
+    powmod(6, -1, 9);
+  } catch (const std::domain_error&) {
+    thrown = true;
+  }
+  assert(thrown);
+
+  thrown = false;
+  try {
+    powmod(6, 5, 0);
+  } catch (const std::domain_error&) {
+    thrown = true;
+  }
+  assert(thrown);
+}
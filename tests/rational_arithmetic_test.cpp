@@ -0,0 +1,89 @@
+#include <cassert>
+#include <random>
+#include "../rational.h"
+#include "reference.h"
+
+// Exact fraction in lowest terms with a positive denominator
+struct Fraction {
+  BigInteger numerator;
+  BigInteger denominator;
+};
+
+Fraction reduce(BigInteger numerator, BigInteger denominator) {
+  if (denominator < 0) {
+    numerator = -numerator;
+    denominator = -denominator;
+  }
+  BigInteger divider = gcd(numerator, denominator);
+  return {numerator / divider, denominator / divider};
+}
+
+std::string text(const Fraction& value) {
+  return (value.denominator == 1) ? value.numerator.toString() : value.numerator.toString() + "/" + value.denominator.toString();
+}
+
+// Henrici's addition and cross-GCD multiplication on multi-limb fractions against exact reduction,
+// eager and lazy values giving the same canonical results
+int main() {
+  std::mt19937_64 generator(14);
+  // Denominators share factors so the GCD shortcuts see both trivial and nontrivial divisors
+  std::vector<BigInteger> factors;
+  for (size_t size : {1, 2, 5, 12}) {
+    factors.emplace_back(reference::decimal(reference::random(generator, size)));
+  }
+  auto random_part = [&]() {
+    BigInteger value = factors[generator() % factors.size()] * factors[generator() % factors.size()];
+    return value * BigInteger(reference::decimal(reference::random(generator, 1 + generator() % 4)));
+  };
+
+  for (int chain = 0; chain < 60; ++chain) {
+    Rational eager;
+    Rational lazy;
+    lazy.setLazy(true);
+    assert(lazy.isLazy() && !eager.isLazy());
+    Fraction expected{0, 1};
+
+    for (int step = 0; step < 8; ++step) {
+      BigInteger numerator = random_part();
+      BigInteger denominator = random_part();
+      if (generator() % 2 == 0) {
+        numerator = -numerator;
+      }
+      Rational operand = Rational(numerator) / Rational(denominator);
+      Fraction exact = reduce(numerator, denominator);
+
+      switch (generator() % 4) {
+        case 0:
+          eager += operand;
+          lazy += operand;
+          expected = reduce(expected.numerator * exact.denominator + exact.numerator * expected.denominator, expected.denominator * exact.denominator);
+          break;
+        case 1:
+          eager -= operand;
+          lazy -= operand;
+          expected = reduce(expected.numerator * exact.denominator - exact.numerator * expected.denominator, expected.denominator * exact.denominator);
+          break;
+        case 2:
+          eager *= operand;
+          lazy *= operand;
+          expected = reduce(expected.numerator * exact.numerator, expected.denominator * exact.denominator);
+          break;
+        default:
+          eager /= operand;
+          lazy /= operand;
+          expected = reduce(expected.numerator * exact.denominator, expected.denominator * exact.numerator);
+          break;
+      }
+      assert(eager.toString() == text(expected));
+    }
+    // Reading the lazy value only now lets the unreduced terms pile up over the whole chain
+    assert(lazy == eager);
+    assert(lazy.toString() == text(expected));
+  }
+
+  // A zero product stays canonical in lazy mode
+  Rational value = Rational(BigInteger("123456789012345678901234567890")) / Rational(7);
+  value.setLazy(true);
+  value *= Rational(0);
+  assert(value == 0 && value.toString() == "0");
+}
@@ -0,0 +1,69 @@
+#include <cassert>
+#include <compare>
+#include <random>
+#include "../rational.h"
+#include "reference.h"
+
+// a / b <=> c / d by the exact cross products, b and d positive
+std::strong_ordering expected_order(const BigInteger& a, const BigInteger& b, const BigInteger& c, const BigInteger& d) {
+  return a * d <=> c * b;
+}
+
+void check(const BigInteger& a, const BigInteger& b, const BigInteger& c, const BigInteger& d) {
+  Rational first = Rational(a) / Rational(b);
+  Rational second = Rational(c) / Rational(d);
+  std::strong_ordering order = expected_order(a, b, c, d);
+  assert((first <=> second) == order);
+  assert((second <=> first) == 0 <=> order);
+  assert((first < second) == (order < 0));
+  assert((first <= second) == (order <= 0));
+  assert((first == second) == (order == 0));
+  assert((first != second) == (order != 0));
+}
+
+// Rational comparison tiers: exponent gaps, leading bits, continued fraction terms and exact products,
+// on pairs built to fall through to each of them
+int main() {
+  std::mt19937_64 generator(16);
+  auto random = [&](size_t size) { return BigInteger(reference::decimal(reference::random(generator, size))); };
+
+  for (int round = 0; round < 100; ++round) {
+    size_t size = 1 + generator() % 40;
+    BigInteger a = random(size), b = random(size), c = random(1 + generator() % 40), d = random(size);
+    // Far apart and random
+    check(a, b, c, d);
+    check(-a, b, c, d);
+    // Equal values in different terms
+    BigInteger k = random(1 + generator() % 3);
+    check(a, b, a * k, b * k);
+    check(-a, b, -a * k, b * k);
+    // Neighbours that agree in exponent and in many leading bits
+    check(a * k, b * k, a * k + 1, b * k);
+    check(a * k + 1, b * k, a, b);
+    check(a, b, a * k - 1, b * k);
+    // Close convergents: a / b against (a * k + c) / (b * k + d) for small c, d
+    check(a, b, a * k + 1, b * k + 1);
+  }
+
+  // Lazy values compared before they are brought to lowest terms
+  for (int round = 0; round < 20; ++round) {
+    BigInteger a = random(1 + generator() % 10), b = random(1 + generator() % 10), k = random(2);
+    Rational first = Rational(a);
+    first.setLazy(true);
+    first /= Rational(b);
+    first *= Rational(k);
+    first /= Rational(k);
+    Rational second = Rational(a) / Rational(b);
+    assert(first == second && (first <=> second) == 0);
+    assert(first < second + Rational(1) / Rational(b * k));
+    assert(-first > -second - Rational(1) / Rational(b * k));
+  }
+
+  // The small tier and mixed tiers
+  check(1, 3, 2, 6);
+  check(-7, 2, -10, 3);
+  check(BigInteger("9223372036854775807"), 1, BigInteger("9223372036854775808"), 1);
+  check(BigInteger("9223372036854775807"), BigInteger("9223372036854775806"), 1, 1);
+  assert(Rational(0) == Rational(0) && !(Rational(0) < Rational(0)));
+  assert(Rational(-1) < Rational(0) && Rational(0) < Rational(1));
+}
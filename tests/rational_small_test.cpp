@@ -0,0 +1,73 @@
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+#include "../rational.h"
+
+// Exact fraction in lowest terms with a positive denominator
+struct Fraction {
+  BigInteger numerator;
+  BigInteger denominator;
+};
+
+Fraction reduce(BigInteger numerator, BigInteger denominator) {
+  if (denominator < 0) {
+    numerator = -numerator;
+    denominator = -denominator;
+  }
+  BigInteger divider = gcd(numerator, denominator);
+  return {numerator / divider, denominator / divider};
+}
+
+std::string text(const Fraction& value) {
+  return (value.denominator == 1) ? value.numerator.toString() : value.numerator.toString() + "/" + value.denominator.toString();
+}
+
+// The int64_t tier against exact fractions: operations that overflow machine words move to the
+// BigInteger tier and results that fit again come back
+int main() {
+  const int64_t max = std::numeric_limits<int64_t>::max();
+  const std::vector<std::pair<int64_t, int64_t>> pool = {
+      {1, 1}, {-1, 2}, {3, 7}, {max, 1}, {-max, 1}, {max, max - 1}, {1, max}, {int64_t(1) << 62, 3}, {-(int64_t(1) << 40), (int64_t(1) << 31) - 1}, {max / 2, 5}};
+
+  std::mt19937_64 generator(15);
+  for (int chain = 0; chain < 200; ++chain) {
+    Rational value;
+    Fraction expected{0, 1};
+    for (int step = 0; step < 12; ++step) {
+      auto [numerator, denominator] = pool[generator() % pool.size()];
+      Rational operand = Rational(BigInteger(numerator)) / Rational(BigInteger(denominator));
+      Fraction exact = reduce(numerator, denominator);
+      assert(operand.toString() == text(exact));
+
+      switch (generator() % 4) {
+        case 0:
+          value += operand;
+          expected = reduce(expected.numerator * exact.denominator + exact.numerator * expected.denominator, expected.denominator * exact.denominator);
+          break;
+        case 1:
+          value -= operand;
+          expected = reduce(expected.numerator * exact.denominator - exact.numerator * expected.denominator, expected.denominator * exact.denominator);
+          break;
+        case 2:
+          value *= operand;
+          expected = reduce(expected.numerator * exact.numerator, expected.denominator * exact.denominator);
+          break;
+        default:
+          value /= operand;
+          expected = reduce(expected.numerator * exact.denominator, expected.denominator * exact.numerator);
+          break;
+      }
+      assert(value.toString() == text(expected));
+    }
+  }
+
+  // Overflow into the BigInteger tier and back
+  Rational big = Rational(BigInteger(max)) * Rational(BigInteger(max));
+  assert(big.toString() == (BigInteger(max) * BigInteger(max)).toString());
+  big /= Rational(BigInteger(max));
+  assert(big.toString() == std::to_string(max));
+  big -= Rational(BigInteger(max));
+  assert(big.toString() == "0");
+}
@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+// Naive arithmetic on little-endian base 2^32 magnitudes, independent of the library, that tests
+// compare BigInteger against. Values pass between the two through decimal strings.
+namespace reference {
+
+using Limbs = std::vector<uint32_t>;
+
+void trim(Limbs& value) {
+  while (!value.empty() && value.back() == 0) {
+    value.pop_back();
+  }
+}
+
+// size limbs with a nonzero top limb, sparse ones are mixed in to hit carry chains
+Limbs random(std::mt19937_64& generator, size_t size) {
+  Limbs value(size);
+  int pattern = static_cast<int>(generator() % 4);
+  for (uint32_t& limb : value) {
+    uint32_t bits = static_cast<uint32_t>(generator());
+    limb = (pattern == 0) ? 0xFFFF'FFFF : (pattern == 1 && bits % 3 != 0 ? 0 : bits);
+  }
+  if (size > 0 && value.back() == 0) {
+    value.back() = 1;
+  }
+  return value;
+}
+
+int compare(const Limbs& first, const Limbs& second) {
+  if (first.size() != second.size()) {
+    return first.size() < second.size() ? -1 : 1;
+  }
+  for (size_t i = first.size(); i-- > 0;) {
+    if (first[i] != second[i]) {
+      return first[i] < second[i] ? -1 : 1;
+    }
+  }
+  return 0;
+}
+
+Limbs add(const Limbs& first, const Limbs& second) {
+  Limbs result(std::max(first.size(), second.size()) + 1);
+  uint64_t carry = 0;
+  for (size_t i = 0; i < result.size(); ++i) {
+    carry += (i < first.size() ? first[i] : 0) + uint64_t(i < second.size() ? second[i] : 0);
+    result[i] = static_cast<uint32_t>(carry);
+    carry >>= 32;
+  }
+  trim(result);
+  return result;
+}
+
+// Requires first >= second
+Limbs subtract(const Limbs& first, const Limbs& second) {
+  Limbs result(first.size());
+  int64_t borrow = 0;
+  for (size_t i = 0; i < first.size(); ++i) {
+    int64_t difference = int64_t(first[i]) - (i < second.size() ? second[i] : 0) - borrow;
+    borrow = difference < 0 ? 1 : 0;
+    result[i] = static_cast<uint32_t>(difference + (borrow << 32));
+  }
+  trim(result);
+  return result;
+}
+
+Limbs multiply(const Limbs& first, const Limbs& second) {
+  Limbs result(first.size() + second.size());
+  for (size_t i = 0; i < first.size(); ++i) {
+    uint64_t carry = 0;
+    for (size_t j = 0; j < second.size(); ++j) {
+      carry += uint64_t(first[i]) * second[j] + result[i + j];
+      result[i + j] = static_cast<uint32_t>(carry);
+      carry >>= 32;
+    }
+    result[i + second.size()] = static_cast<uint32_t>(carry);
+  }
+  trim(result);
+  return result;
+}
+
+// Divides value in place, returns the remainder
+uint32_t divide_small(Limbs& value, uint32_t divider) {
+  uint64_t remainder = 0;
+  for (size_t i = value.size(); i-- > 0;) {
+    remainder = (remainder << 32) | value[i];
+    value[i] = static_cast<uint32_t>(remainder / divider);
+    remainder %= divider;
+  }
+  trim(value);
+  return static_cast<uint32_t>(remainder);
+}
+
+std::string decimal(Limbs value) {
+  trim(value);
+  if (value.empty()) {
+    return "0";
+  }
+  std::string digits;
+  while (!value.empty()) {
+    uint32_t chunk = divide_small(value, 1'000'000'000);
+    for (int i = 0; i < 9 && (!value.empty() || chunk != 0); ++i) {
+      digits.push_back(static_cast<char>('0' + chunk % 10));
+      chunk /= 10;
+    }
+  }
+  std::reverse(digits.begin(), digits.end());
+  return digits;
+}
+
+// Whether quotient and remainder are the Euclidean division of dividend by divider:
+// dividend == quotient * divider + remainder with remainder < divider
+bool is_division(const Limbs& dividend, const Limbs& divider, const Limbs& quotient, const Limbs& remainder) {
+  return compare(add(multiply(quotient, divider), remainder), dividend) == 0 && compare(remainder, divider) < 0;
+}
+
+// Magnitude of a decimal string with an optional '-'
+Limbs parse(const std::string& text) {
+  Limbs value;
+  for (char character : text) {
+    if (character == '-') {
+      continue;
+    }
+    uint64_t carry = static_cast<uint64_t>(character - '0');
+    for (uint32_t& limb : value) {
+      carry += uint64_t(limb) * 10;
+      limb = static_cast<uint32_t>(carry);
+      carry >>= 32;
+    }
+    if (carry != 0) {
+      value.push_back(static_cast<uint32_t>(carry));
+    }
+  }
+  trim(value);
+  return value;
+}
+
+}  // namespace reference
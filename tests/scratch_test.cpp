@@ -0,0 +1,130 @@
+#include <cassert>
+#include <memory_resource>
+#include <random>
+#include <thread>
+#include <vector>
+#include "../biginteger.h"
+#include "reference.h"
+
+// Forwards to the global heap and counts the blocks still outstanding
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  size_t allocations = 0;
+  size_t outstanding = 0;
+
+ private:
+  void* do_allocate(size_t bytes, size_t alignment) override {
+    ++allocations;
+    ++outstanding;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(void* pointer, size_t bytes, size_t alignment) override {
+    --outstanding;
+    std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+  }
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+BigInteger random_number(std::mt19937_64& generator, size_t size) {
+  return BigInteger(reference::decimal(reference::random(generator, size)));
+}
+
+bool is_product(const BigInteger& product, const BigInteger& first, const BigInteger& second) {
+  return product.toString() == reference::decimal(reference::multiply(reference::parse(first.toString()), reference::parse(second.toString())));
+}
+
+// Values built in scratch arenas and scoped memory resources: they outlive their scopes, nest, move
+// on to fresh arenas once one fills up, and every block is given back to the resource it came from
+int main() {
+  std::mt19937_64 generator(22);
+
+  // Results escape nested scratch scopes, including blocks too large for the arena
+  std::vector<BigInteger> first, second, products;
+  {
+    ScratchScope outer;
+    for (size_t size : {3, 30, 300, 3000, 17000}) {
+      first.push_back(size <= 300 ? random_number(generator, size) : power(first[2], size / 300) + 1);
+      second.push_back(size <= 300 ? random_number(generator, size / 2 + 1) : power(second[2], size / 300) - 1);
+      ScratchScope inner;
+      products.push_back(first.back() * second.back());
+    }
+  }
+  for (size_t i = 0; i < products.size(); ++i) {
+    assert(i >= 3 ? products[i] == first[i] * second[i] : is_product(products[i], first[i], second[i]));
+  }
+
+  // Enough scratch allocations to fill several arenas, with some values kept alive across them
+  std::vector<BigInteger> kept;
+  {
+    ScratchScope scratch;
+    BigInteger base = random_number(generator, 1000), modulus = random_number(generator, 300);
+    BigInteger accumulator = 1;
+    for (int round = 0; round < 400; ++round) {
+      BigInteger value = base * (round + 1) + round;
+      accumulator = (accumulator * value) % modulus;
+      if (round % 50 == 0) {
+        kept.push_back(value);
+        kept.push_back(accumulator);
+      }
+    }
+  }
+  for (size_t i = 0; i + 1 < kept.size(); i += 2) {
+    assert(BigInteger(kept[i].toString()) == kept[i]);
+    assert(BigInteger(kept[i + 1].toString()) == kept[i + 1]);
+  }
+
+  // gcd and powmod run in the arena but return values from the caller's resource
+  CountingResource counting;
+  {
+    MemoryScope scope(&counting);
+    BigInteger a = random_number(generator, 60), b = random_number(generator, 30), c = random_number(generator, 50);
+    BigInteger divisor = gcd(a * c, b * c);
+    assert(divisor % c == 0 && gcd(a * c / divisor, b * c / divisor) == 1);
+    size_t before = counting.outstanding;
+    BigInteger result = powmod(a, b, c + 1);
+    assert(counting.outstanding == before + 1);
+    assert(result < c + 1 && result == powmod(a % (c + 1), b, c + 1));
+    {
+      ScratchScope scratch;
+      assert(gcd(a * c, b * c) == divisor);
+      assert(powmod(a, b, c + 1) == result);
+    }
+  }
+  assert(counting.allocations > 0 && counting.outstanding == 0);
+
+  // Values allocated in a MemoryScope may outlive it, but not the resource
+  {
+    CountingResource resource;
+    {
+      BigInteger escaped;
+      {
+        MemoryScope scope(&resource);
+        escaped = random_number(generator, 100) * random_number(generator, 100);
+      }
+      assert(resource.outstanding > 0);
+      escaped *= escaped;
+    }
+    assert(resource.outstanding == 0);
+  }
+
+  // Every thread has an arena of its own
+  std::vector<std::thread> threads;
+  std::vector<char> correct(4);
+  for (size_t i = 0; i < correct.size(); ++i) {
+    threads.emplace_back([&, i, seed = generator()] {
+      std::mt19937_64 local(seed);
+      bool ok = true;
+      for (int round = 0; round < 50; ++round) {
+        ScratchScope scratch;
+        BigInteger a = random_number(local, 1 + local() % 500), b = random_number(local, 1 + local() % 500);
+        BigInteger product = a * b;
+        ok = ok && product / b == a && product % a == 0;
+      }
+      correct[i] = ok;
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  assert(correct == std::vector<char>(correct.size(), true));
+}
@@ -0,0 +1,155 @@
+#include <cassert>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "../biginteger.h"
+#include "reference.h"
+
+using mpn::limb;
+using Limbs = std::vector<limb>;
+
+struct Kernels {
+  limb (*add_n)(limb*, const limb*, const limb*, size_t);
+  limb (*sub_n)(limb*, const limb*, const limb*, size_t);
+  limb (*mul_1)(limb*, const limb*, size_t, limb);
+  limb (*addmul_1)(limb*, const limb*, size_t, limb);
+  limb (*submul_1)(limb*, const limb*, size_t, limb);
+};
+
+// Limbs with long runs of ones and zeros, so that carries travel across whole vectors
+Limbs operand(std::mt19937_64& generator, size_t size) {
+  Limbs result(size);
+  int pattern = generator() % 4;
+  for (limb& value : result) {
+    value = pattern == 0 ? ~limb(0) : pattern == 1 ? limb(0) : pattern == 2 && generator() % 8 ? ~limb(0) : limb(generator());
+  }
+  return result;
+}
+
+void check(const Kernels& kernels, std::mt19937_64& generator, size_t size) {
+  Limbs first = operand(generator, size), second = operand(generator, size), accumulator = operand(generator, size);
+  limb multiplier = generator() % 3 == 0 ? ~limb(0) : limb(generator());
+
+  Limbs result(size), expected(size);
+  uint64_t carry = 0;
+  for (size_t i = 0; i < size; ++i) {
+    carry += uint64_t(first[i]) + second[i];
+    expected[i] = limb(carry);
+    carry >>= 32;
+  }
+  assert(kernels.add_n(result.data(), first.data(), second.data(), size) == carry && result == expected);
+
+  uint64_t borrow = 0;
+  for (size_t i = 0; i < size; ++i) {
+    uint64_t diff = uint64_t(first[i]) - second[i] - borrow;
+    expected[i] = limb(diff);
+    borrow = diff >> 63;
+  }
+  assert(kernels.sub_n(result.data(), first.data(), second.data(), size) == borrow && result == expected);
+
+  carry = 0;
+  for (size_t i = 0; i < size; ++i) {
+    carry += uint64_t(first[i]) * multiplier;
+    expected[i] = limb(carry);
+    carry >>= 32;
+  }
+  assert(kernels.mul_1(result.data(), first.data(), size, multiplier) == carry && result == expected);
+
+  carry = 0;
+  for (size_t i = 0; i < size; ++i) {
+    carry += uint64_t(first[i]) * multiplier + accumulator[i];
+    expected[i] = limb(carry);
+    carry >>= 32;
+  }
+  result = accumulator;
+  assert(kernels.addmul_1(result.data(), first.data(), size, multiplier) == carry && result == expected);
+
+  borrow = 0;
+  for (size_t i = 0; i < size; ++i) {
+    uint64_t product = uint64_t(first[i]) * multiplier + borrow;
+    expected[i] = accumulator[i] - limb(product);
+    borrow = (product >> 32) + (accumulator[i] < limb(product));
+  }
+  result = accumulator;
+  assert(kernels.submul_1(result.data(), first.data(), size, multiplier) == borrow && result == expected);
+}
+
+BigInteger number_of(Limbs limbs) {
+  reference::trim(limbs);
+  return BigInteger(reference::decimal(limbs));
+}
+
+void check_butterflies(std::mt19937_64& generator, size_t size) {
+  const unsigned modulus = 998244353;
+  std::vector<unsigned> even(size), odd(size), roots(size), quotients(size);
+  for (size_t k = 0; k < size; ++k) {
+    even[k] = generator() % modulus;
+    odd[k] = generator() % modulus;
+    roots[k] = generator() % 4 == 0 ? modulus - 1 : generator() % modulus;
+    quotients[k] = (uint64_t(roots[k]) << 32) / modulus;
+  }
+  std::vector<unsigned> sums(size), differences(size);
+  for (size_t k = 0; k < size; ++k) {
+    uint64_t t = uint64_t(roots[k]) * odd[k] % modulus;
+    sums[k] = (even[k] + t) % modulus;
+    differences[k] = (even[k] + modulus - t) % modulus;
+  }
+  mpn::ntt_butterflies(even.data(), odd.data(), roots.data(), quotients.data(), size, modulus);
+  assert(even == sums && odd == differences);
+}
+
+// Vector kernels against scalar loops at sizes around SIMD_MIN_SIZE and the vector widths, through the
+// dispatch and, where the CPU has them, through the AVX2 and AVX-512 variants directly
+int main() {
+  std::mt19937_64 generator(20);
+
+  std::vector<Kernels> variants = {{mpn::add_n, mpn::sub_n, mpn::mul_1, mpn::addmul_1, mpn::submul_1}};
+#ifdef BIGINTEGER_X86_SIMD
+  if (mpn::simd_support() != mpn::simd_level::SCALAR) {
+    variants.push_back({mpn::add_n_avx2, mpn::sub_n_avx2, mpn::mul_1_avx2, mpn::addmul_1_avx2, mpn::submul_1_avx2});
+  }
+  if (mpn::simd_support() == mpn::simd_level::AVX512) {
+    variants.push_back({mpn::add_n_avx512, mpn::sub_n_avx512, mpn::mul_1_avx512, mpn::addmul_1_avx512, mpn::submul_1_avx512});
+  }
+#endif
+
+  for (const Kernels& kernels : variants) {
+    for (size_t size = 1; size <= 80; ++size) {
+      for (int round = 0; round < 20; ++round) {
+        check(kernels, generator, size);
+      }
+    }
+    for (size_t size : {127, 255, 1000, 1023}) {
+      check(kernels, generator, size);
+    }
+  }
+
+  for (size_t size = 1; size <= 70; ++size) {
+    check_butterflies(generator, size);
+  }
+  check_butterflies(generator, 1024);
+
+  // add_1, sub_1 and divrem_1 have no vector variants, but run next to them on the same limbs
+  for (int round = 0; round < 500; ++round) {
+    size_t size = 1 + generator() % 40;
+    Limbs first = operand(generator, size), result(size);
+    limb value = generator() % 2 ? 1 : limb(generator());
+    BigInteger number = number_of(first);
+
+    limb carry = mpn::add_1(result.data(), first.data(), size, value);
+    Limbs sum = result;
+    sum.push_back(carry);
+    assert(number_of(sum) == number + BigInteger(static_cast<long long>(value)));
+
+    limb borrow = mpn::sub_1(result.data(), first.data(), size, value);
+    assert(borrow == (number < BigInteger(static_cast<long long>(value))));
+    if (!borrow) {
+      assert(number_of(result) == number - BigInteger(static_cast<long long>(value)));
+    }
+
+    limb divider = value == 0 ? 1 : value;
+    limb remainder = mpn::divrem_1(result.data(), first.data(), size, divider);
+    assert(number_of(result) * BigInteger(static_cast<long long>(divider)) + BigInteger(static_cast<long long>(remainder)) == number);
+    assert(remainder < divider);
+  }
+}